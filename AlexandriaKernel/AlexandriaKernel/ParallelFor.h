@@ -0,0 +1,75 @@
+/*
+ * Copyright (C) 2012-2020 Euclid Science Ground Segment
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+/**
+ * @file AlexandriaKernel/ParallelFor.h
+ * @date October 18, 2026
+ */
+
+#ifndef _ALEXANDRIAKERNEL_PARALLELFOR_H
+#define _ALEXANDRIAKERNEL_PARALLELFOR_H
+
+#include "AlexandriaKernel/ThreadPool.h"
+#include <algorithm>
+#include <thread>
+
+namespace Euclid {
+
+/**
+ * @brief Split the range [0, n) in contiguous chunks, and process them in parallel
+ * @details
+ * The function f is called as f(begin, end) once per chunk. The chunks do not overlap, and
+ * together they cover the whole range, so f can write to disjoint parts of an output without
+ * any synchronization.
+ * If only one thread is requested, or the range is not bigger than min_chunk, f is called
+ * directly from the calling thread, so there is no overhead for small inputs.
+ * If any call throws, the exception is re-thrown from the calling thread once all the
+ * running chunks have finished.
+ * @param n
+ *  Size of the range
+ * @param n_threads
+ *  Number of threads to use. 0 means one per available core
+ * @param f
+ *  Callable with the signature void(size_t begin, size_t end)
+ * @param min_chunk
+ *  Minimum number of elements per chunk
+ */
+template <typename F>
+void parallelFor(size_t n, unsigned int n_threads, F&& f, size_t min_chunk = 1) {
+  if (n_threads == 0)
+    n_threads = std::max(1u, std::thread::hardware_concurrency());
+  size_t n_chunks = std::min<size_t>(n_threads, (n + min_chunk - 1) / std::max<size_t>(min_chunk, 1));
+  if (n_chunks <= 1) {
+    f(size_t{0}, n);
+    return;
+  }
+
+  ThreadPool pool{static_cast<unsigned int>(n_chunks), 1};
+  size_t     chunk = n / n_chunks, remainder = n % n_chunks;
+  size_t     begin = 0;
+  for (size_t i = 0; i < n_chunks; ++i) {
+    size_t end = begin + chunk + (i < remainder ? 1 : 0);
+    pool.submit([&f, begin, end]() { f(begin, end); });
+    begin = end;
+  }
+  pool.block();
+}
+
+}  // namespace Euclid
+
+#endif  // _ALEXANDRIAKERNEL_PARALLELFOR_H
@@ -0,0 +1,80 @@
+/*
+ * Copyright (C) 2012-2020 Euclid Science Ground Segment
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#include <atomic>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+
+#include "AlexandriaKernel/ParallelFor.h"
+#include "ElementsKernel/Exception.h"
+
+using namespace Euclid;
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_SUITE(ParallelFor_test)
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_CASE(coverage_test) {
+  for (unsigned int n_threads : {1u, 2u, 3u, 8u}) {
+    std::vector<int>    visited(1001, 0);
+    std::atomic<size_t> calls{0};
+    parallelFor(visited.size(), n_threads, [&visited, &calls](size_t begin, size_t end) {
+      ++calls;
+      for (size_t i = begin; i < end; ++i) {
+        ++visited[i];
+      }
+    });
+    BOOST_CHECK_EQUAL(calls, n_threads);
+    for (auto v : visited) {
+      BOOST_CHECK_EQUAL(v, 1);
+    }
+  }
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_CASE(minChunk_test) {
+  std::atomic<size_t> calls{0};
+  parallelFor(10, 4, [&calls](size_t, size_t) { ++calls; }, 100);
+  BOOST_CHECK_EQUAL(calls, 1);
+
+  calls = 0;
+  parallelFor(0, 4, [&calls](size_t begin, size_t end) {
+    ++calls;
+    BOOST_CHECK_EQUAL(begin, end);
+  });
+  BOOST_CHECK_EQUAL(calls, 1);
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_CASE(exception_test) {
+  BOOST_CHECK_THROW(parallelFor(100, 4,
+                                [](size_t begin, size_t) {
+                                  if (begin == 0)
+                                    throw Elements::Exception();
+                                }),
+                    Elements::Exception);
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_SUITE_END()
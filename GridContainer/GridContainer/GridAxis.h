@@ -25,7 +25,9 @@
 #ifndef GRIDCONTAINER_GRIDAXIS_H
 #define GRIDCONTAINER_GRIDAXIS_H
 
+#include "GridContainer/_impl/GridAxisIndex.h"
 #include <string>
+#include <utility>
 #include <vector>
 
 namespace Euclid {
@@ -43,6 +45,11 @@ namespace GridContainer {
  * by using the (zero based) index of the knot. Note that the GridAxis is
  * designed to be immutable.
  *
+ * The knots can also be looked up by value. An index is built when the axis is
+ * constructed, so the lookup does not need to scan the knots: uniform numerical
+ * axes compute the position, increasing numerical axes use a binary search, and
+ * any other hashable type (i.e. std::string) uses a hash map.
+ *
  * @tparam T the type of the axis values
  */
 template <typename T>
@@ -76,6 +83,29 @@ public:
   /// Returns an iterator after the last knot of the axis
   const_iterator end() const;
 
+  /// Returns an iterator at the first knot with the given value, or end() if there is none
+  const_iterator find(const T& value) const;
+
+  /**
+   * @brief
+   * Returns the index of the knot closest to the given value
+   * @details
+   * Values out of the axis range give the first or the last knot.
+   * @throws Elements::Exception
+   *    if the knots are not numerical and increasing
+   */
+  size_t nearest(const T& value) const;
+
+  /**
+   * @brief
+   * Returns the indices (i, i+1) of the two consecutive knots which enclose the given value
+   * @details
+   * The returned knots fulfil axis[i] <= value <= axis[i+1]
+   * @throws Elements::Exception
+   *    if the knots are not numerical and increasing, or the value is out of the axis range
+   */
+  std::pair<size_t, size_t> bracket(const T& value) const;
+
   /**
    * @brief
    * Compares the axis with another axis
@@ -96,8 +126,9 @@ public:
   bool operator!=(const GridAxis<U>& other) const;
 
 private:
-  std::string    m_name;
-  std::vector<T> m_values;
+  std::string      m_name;
+  std::vector<T>   m_values;
+  GridAxisIndex<T> m_index;
 };
 
 }  // end of namespace GridContainer
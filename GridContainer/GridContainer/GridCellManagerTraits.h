@@ -26,6 +26,7 @@
 #define GRIDCONTAINER_GRIDCELLMANAGERTRAITS_H
 
 #include <memory>
+#include <utility>
 #include <vector>
 
 namespace Euclid {
@@ -95,6 +96,17 @@ struct GridCellManagerTraits {
    */
   static iterator end(GridCellManager& cell_manager);
 
+  /**
+   * Returns the ranges [first, second) of the positions of the cells which are
+   * stored by the GridCellManager, in increasing order. Sparse GridCellManager%s
+   * use it to skip the cells which are not stored. By default all the cells are
+   * stored, so it returns a single range with all of them.
+   *
+   * @param cell_manager the GridCellManager
+   * @return The ranges of the stored cells
+   */
+  static std::vector<std::pair<size_t, size_t>> nonEmptyRanges(const GridCellManager& cell_manager);
+
   /// Flag which indicates if the GridCellManager is boost serializable. By default
   /// it is set to false. Note that Grids which use CellManagers which have
   /// this flag set to false cannot be serialized.
@@ -132,11 +144,48 @@ struct GridCellManagerTraits<std::vector<T>> {
   /// Returns an iterator right after the last element of the vector
   static iterator end(std::vector<T>& vector);
 
+  /// Returns a single range with all the elements of the vector
+  static std::vector<std::pair<size_t, size_t>> nonEmptyRanges(const std::vector<T>& vector);
+
   /// Enables boost serialization of Grids using vector%s as GridCellManager%s
   static const bool enable_boost_serialize = true;
 
 };  // end of GridCellManagerTraits vector specialization
 
+/// Defines type as void, if all the types it is given are valid
+template <typename...>
+struct GridCellManagerVoid {
+  typedef void type;
+};
+
+/**
+ * @class GridCellReferences
+ *
+ * @brief The types returned by the GridContainer when its cells are accessed
+ *
+ * @details
+ * By default they are references to the data_type of the GridCellManagerTraits.
+ * GridCellManager%s which do not keep the cells as plain objects define in their
+ * GridCellManagerTraits the types reference and const_reference, which are used
+ * instead. They can be proxies (i.e. to store a cell only when it is written) or
+ * values (i.e. for read-only cells which are computed on access). The operator[]
+ * and the iterator of the GridCellManager must return the same types.
+ *
+ * @tparam GridCellManager the manager which keeps the GridContainer data
+ */
+template <typename GridCellManager, typename = void>
+struct GridCellReferences {
+  typedef typename GridCellManagerTraits<GridCellManager>::data_type&       reference;
+  typedef const typename GridCellManagerTraits<GridCellManager>::data_type& const_reference;
+};
+
+template <typename GridCellManager>
+struct GridCellReferences<GridCellManager,
+                          typename GridCellManagerVoid<typename GridCellManagerTraits<GridCellManager>::reference>::type> {
+  typedef typename GridCellManagerTraits<GridCellManager>::reference       reference;
+  typedef typename GridCellManagerTraits<GridCellManager>::const_reference const_reference;
+};
+
 }  // end of namespace GridContainer
 }  // end of namespace Euclid
 
@@ -28,6 +28,7 @@
 #include "GridContainer/GridCellManagerTraits.h"
 #include "GridContainer/GridIndexHelper.h"
 #include "GridContainer/_impl/GridConstructionHelper.h"
+#include <array>
 #include <iterator>
 #include <map>
 #include <memory>
@@ -103,6 +104,12 @@ public:
   /// The type of the values stored in the grid cells
   typedef typename GridCellManagerTraits<GridCellManager>::data_type cell_type;
 
+  /// The type returned by the access to a cell, a reference unless the GridCellManager defines otherwise
+  typedef typename GridCellReferences<GridCellManager>::reference reference;
+
+  /// The type returned by the constant access to a cell
+  typedef typename GridCellReferences<GridCellManager>::const_reference const_reference;
+
   /// The type of the tuple keeping the axes of the grid
   typedef std::tuple<GridAxis<AxesTypes>...> AxesTuple;
 
@@ -137,6 +144,19 @@ public:
    */
   explicit GridContainer(std::tuple<GridAxis<AxesTypes>...> axes_tuple);
 
+  /**
+   * @brief Constructs a GridContainer with the given axes, keeping the cells of an existing GridCellManager
+   * @details
+   * The cells are not copied, so this can be used for grids which keep their data
+   * outside of the memory, like in a memory mapped file.
+   *
+   * @param axes_tuple the GridAxis%es describing the axes of the grid
+   * @param cell_manager the GridCellManager keeping the cells, in the iteration order of the grid
+   * @throws Elements::Exception
+   *    if the number of cells of the GridCellManager does not match the axes
+   */
+  GridContainer(std::tuple<GridAxis<AxesTypes>...> axes_tuple, std::unique_ptr<GridCellManager> cell_manager);
+
   /// Default move constructor and move assignment operator
   GridContainer(GridContainer<GridCellManager, AxesTypes...>&&) = default;
   GridContainer& operator=(GridContainer<GridCellManager, AxesTypes...>&&) = default;
@@ -196,10 +216,10 @@ public:
    * @param indices The indices of the axes
    * @return A reference to the cell
    */
-  const cell_type& operator()(decltype(std::declval<GridAxis<AxesTypes>>().size())... indices) const;
+  const_reference operator()(decltype(std::declval<GridAxis<AxesTypes>>().size())... indices) const;
 
   /// @copydoc operator() (decltype(std::declval<GridAxis<AxesTypes>>().size())...) const
-  cell_type& operator()(decltype(std::declval<GridAxis<AxesTypes>>().size())... indices);
+  reference operator()(decltype(std::declval<GridAxis<AxesTypes>>().size())... indices);
 
   /**
    * Returns a reference to the grid cell for the given axes indices, to be
@@ -213,10 +233,61 @@ public:
    * @throws Elements::Exception
    *    if any of the indices is out of range
    */
-  const cell_type& at(decltype(std::declval<GridAxis<AxesTypes>>().size())... indices) const;
+  const_reference at(decltype(std::declval<GridAxis<AxesTypes>>().size())... indices) const;
 
   /// @copydoc at(decltype(std::declval<GridAxis<AxesTypes>>().size())...) const
-  cell_type& at(decltype(std::declval<GridAxis<AxesTypes>>().size())... indices);
+  reference at(decltype(std::declval<GridAxis<AxesTypes>>().size())... indices);
+
+  /**
+   * @brief Calls a function for every cell of the grid, using several threads
+   * @details
+   * The cells are split in contiguous ranges, following the same order as the
+   * iterator, and each thread goes through its range with its own iterator. The
+   * function is called as f(iter), with iter pointing to the cell, so it can also
+   * access the axes information with iter.axisIndex() and iter.axisValue(). For a
+   * slice, only the cells of the slice are visited.
+   *
+   * The function is called concurrently, so it must be safe to call it from
+   * several threads. Each call should only modify the cell it receives. If any
+   * call throws, the exception is rethrown once all the threads have finished.
+   *
+   * @param f The function to call, with the signature void(iterator&)
+   * @param n_threads Number of threads to use, 1 by default. 0 means one per available core.
+   */
+  template <typename F>
+  void forEachCell(F&& f, unsigned int n_threads = 1);
+
+  /// @copydoc forEachCell(F&&, unsigned int). The signature of f is void(const_iterator&).
+  template <typename F>
+  void forEachCell(F&& f, unsigned int n_threads = 1) const;
+
+  /**
+   * @brief Replaces every cell of the grid by the result of a function, using several threads
+   * @details
+   * Works as forEachCell(), but the function is called as f(iter), with iter a
+   * constant iterator pointing to the cell, and its result is assigned to the cell.
+   *
+   * @param f The function computing the cells, with the signature cell_type(const iterator&)
+   * @param n_threads Number of threads to use, 1 by default. 0 means one per available core.
+   */
+  template <typename F>
+  void transformCells(F&& f, unsigned int n_threads = 1);
+
+  /**
+   * @brief Calls a function for the cells which are stored by the GridCellManager
+   * @details
+   * Sparse GridCellManager%s do not store the cells which were never written,
+   * and this method skips them, so its cost depends on the number of stored
+   * cells and not on the size of the grid. The cells are visited in the order
+   * of the iterator, and for a slice only the cells of the slice are visited.
+   * Which cells are stored is given by GridCellManagerTraits::nonEmptyRanges(),
+   * so for GridCellManager%s storing all the cells (like vectors) this is the
+   * same as iterating through the grid.
+   *
+   * @param f The function to call, with the signature void(const_iterator&)
+   */
+  template <typename F>
+  void forEachNonEmptyCell(F&& f) const;
 
   /**
    * @brief Returns a slice of the grid based on an axis index
@@ -363,6 +434,14 @@ private:
   template <int I>
   const GridAxis<axis_type<I>>& getOriginalAxis() const;
 
+  /// Returns an iterator to the cell at the given position of the iteration order
+  /// of the grid (which for a slice goes only through its cells)
+  template <typename IterType>
+  IterType iteratorAt(size_t position) const;
+
+  /// Returns the position in the GridCellManager of the cell with the given indices
+  size_t cellIndex(decltype(std::declval<GridAxis<AxesTypes>>().size())... indices) const;
+
 };  // end of class GridContainer
 
 /**
@@ -377,11 +456,20 @@ private:
  * methods axisIndex() and axisValue() can be used to access the axes
  * information. Slicing can be achieved by using the fixAxisByIndex() and
  * fixAxisByValue() methods.
+ *
+ * The iterator keeps the coordinates of its cell, updated like an odometer on each
+ * step, so axisIndex() does not need any division, and iterating through a slice
+ * costs the same as iterating through the full grid.
  */
 template <typename GridCellManager, typename... AxesTypes>
 template <typename CellType>
-class GridContainer<GridCellManager, AxesTypes...>::iter : public std::iterator<std::forward_iterator_tag, CellType> {
+class GridContainer<GridCellManager, AxesTypes...>::iter
+    : public std::iterator<std::forward_iterator_tag, CellType, std::ptrdiff_t, CellType*,
+                           typename std::conditional<std::is_const<CellType>::value, const_reference, reference>::type> {
 public:
+  /// The type returned by the access to the cell, which is const_reference for the constant iterators
+  typedef typename std::conditional<std::is_const<CellType>::value, const_reference, reference>::type cell_reference;
+
   /**
    * @brief Constructs a new iterator for the given grid
    * @details
@@ -393,6 +481,18 @@ public:
    */
   iter(const GridContainer<GridCellManager, AxesTypes...>& owner, const cell_manager_iter_type& data_iter);
 
+  /**
+   * @brief Constructs a new iterator for the given grid, when the position of data_iter is already known
+   * @details
+   * This avoids computing the position from the beginning of the GridCellManager. For the end
+   * iterator, created on every comparison of a loop, the coordinates are not computed either.
+   *
+   * @param owner The grid to iterate through
+   * @param data_iter The GridCellManager iterator indicating the cell position
+   * @param index The position of data_iter in the GridCellManager
+   */
+  iter(const GridContainer<GridCellManager, AxesTypes...>& owner, const cell_manager_iter_type& data_iter, size_t index);
+
   /// Copy constructor
   iter(const iter<CellType>&) = default;
 
@@ -406,10 +506,10 @@ public:
   iter& operator++();
 
   /// Returns a reference to the cell value
-  CellType& operator*();
+  cell_reference operator*();
 
   /// Returns a reference to the cell value (const version)
-  typename std::add_const<CellType>::type& operator*() const;
+  const_reference operator*() const;
 
   /// Returns a pointer to the cell value
   CellType* operator->();
@@ -484,10 +584,29 @@ public:
   iter& fixAllAxes(const OtherIter& other);
 
 private:
+  /// The GridCellManager iterator, accessed as const by the constant iterators
+  typedef typename std::conditional<std::is_const<CellType>::value, const cell_manager_iter_type, cell_manager_iter_type>::type
+      data_iter_access;
+
   const GridContainer<GridCellManager, AxesTypes...>& m_owner;
   cell_manager_iter_type                              m_data_iter;
-  std::map<size_t, size_t>                            m_fixed_indices;
-  void                                                forwardToIndex(size_t axis, size_t fixed_index);
+  /// True when m_index and m_coords follow m_data_iter. Until an axis is fixed or read, the
+  /// iterator only moves m_data_iter, as for a plain loop over the cells.
+  mutable bool m_tracked;
+  /// Position of the cell in the GridCellManager
+  mutable size_t m_index;
+  /// Coordinates of the cell
+  mutable std::array<size_t, sizeof...(AxesTypes)> m_coords;
+  /// Index of the fixed axes, or FREE_AXIS for the ones the iterator moves through
+  std::array<size_t, sizeof...(AxesTypes)> m_fixed_indices;
+  /// First axis which is not fixed, its size and its step in the GridCellManager
+  mutable size_t m_inner_axis, m_inner_size, m_inner_step;
+
+  void forwardToIndex(size_t axis, size_t fixed_index);
+  void moveToIndex(size_t index);
+  void updateInnerAxis() const;
+  void track() const;
+  void carry();
 
 };  // end of class iter
 
@@ -0,0 +1,204 @@
+/*
+ * Copyright (C) 2012-2020 Euclid Science Ground Segment
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+/**
+ * @file GridContainer/GridInterpolator.h
+ * @date October 19, 2026
+ */
+
+#ifndef GRIDCONTAINER_GRIDINTERPOLATOR_H
+#define GRIDCONTAINER_GRIDINTERPOLATOR_H
+
+#include "GridContainer/GridContainer.h"
+#include "GridContainer/_impl/TemplateLoopCounter.h"
+#include <array>
+#include <type_traits>
+#include <vector>
+
+namespace Euclid {
+namespace GridContainer {
+
+/// The interpolation applied along an axis of the grid
+enum class InterpolationMethod {
+  LINEAR,  ///< Uses the two knots enclosing the value
+  CUBIC    ///< Uses the four knots around the value (Lagrange polynomial)
+};
+
+/**
+ * @class InterpolationCellTraits
+ *
+ * @brief Arithmetic operations used by the GridInterpolator on the grid cells
+ *
+ * @details
+ * The interpolated value is a weighted sum of the cells around the query point, so the
+ * GridInterpolator only needs to create a zero value and to accumulate weighted cells.
+ * This default implementation supports floating point cells. The specialization for std::vector
+ * supports cells with an array of floating point values (i.e. one flux per filter). Other cell
+ * types can be supported by declaring a specialization of this trait.
+ *
+ * @tparam T the type of the grid cells
+ */
+template <typename T, typename = void>
+struct InterpolationCellTraits {
+
+  static_assert(std::is_floating_point<T>::value, "InterpolationCellTraits must be specialized for this cell type");
+
+  /// Returns a value with the same shape as the given cell, set to zero
+  static T zero(const T&) {
+    return T{};
+  }
+
+  /// Adds weight * cell to result
+  static void accumulate(T& result, double weight, const T& cell) {
+    result += weight * cell;
+  }
+};
+
+/// Specialization for cells with an array of values, which are all interpolated together
+template <typename T>
+struct InterpolationCellTraits<std::vector<T>> {
+
+  static_assert(std::is_floating_point<T>::value, "Only vectors of floating point values can be interpolated");
+
+  static std::vector<T> zero(const std::vector<T>& cell) {
+    return std::vector<T>(cell.size());
+  }
+
+  /// Adds weight * cell to result. All the cells of the grid must have the same size.
+  static void accumulate(std::vector<T>& result, double weight, const std::vector<T>& cell);
+};
+
+/**
+ * @class GridInterpolator
+ *
+ * @brief Evaluates a GridContainer at values which are not knots of its axes
+ *
+ * @details
+ * The interpolation is done along each axis independently, using for each one the method
+ * given at construction (multilinear by default). The knots around the query point are
+ * found with GridAxis::bracket(), so the lookup does not scan the axes. The result is the
+ * weighted sum of the surrounding cells, computed with the InterpolationCellTraits of the
+ * cell type, so cells with an array of values are interpolated with a single pass over each
+ * cell.
+ *
+ * All the axes must have numerical and strictly increasing knots. Axes with a single knot
+ * (i.e. the fixed axes of a slice) accept only their knot value. Cubic interpolation
+ * along axes with less than four knots falls back to linear interpolation. Values out of the
+ * range of an axis are not extrapolated.
+ *
+ * The interpolator keeps a reference to the grid, so the grid must outlive it. The
+ * interpolator does not modify its state when evaluated, so it can be used concurrently
+ * by several threads.
+ *
+ * @tparam GridCellManager the cell manager of the grid
+ * @tparam AxesTypes the types of the grid axes
+ */
+template <typename GridCellManager, typename... AxesTypes>
+class GridInterpolator {
+
+public:
+  /// The type of the interpolated grid
+  typedef GridContainer<GridCellManager, AxesTypes...> grid_type;
+
+  /// The type of the interpolated values
+  typedef typename grid_type::cell_type cell_type;
+
+  /// The coordinates of a query point, one per axis
+  typedef std::array<double, sizeof...(AxesTypes)> point_type;
+
+  /**
+   * Constructs an interpolator which uses the given method along each axis
+   *
+   * @param grid The grid to interpolate
+   * @param methods The interpolation method of each axis
+   * @throws Elements::Exception
+   *    if any axis does not have strictly increasing knots
+   */
+  explicit GridInterpolator(const grid_type&                                             grid,
+                            const std::array<InterpolationMethod, sizeof...(AxesTypes)>& methods = linear());
+
+  /**
+   * Interpolates the grid at the given point
+   *
+   * @param point The value of each axis
+   * @return The interpolated cell
+   * @throws Elements::Exception
+   *    if any value is out of the range of its axis
+   */
+  cell_type operator()(const point_type& point) const;
+
+  /**
+   * Interpolates the grid at a batch of points
+   *
+   * @param points The query points
+   * @param n_threads Number of threads to use. 0 means one per available core.
+   * @return The interpolated cells, in the same order as the points
+   * @throws Elements::Exception
+   *    if any value is out of the range of its axis
+   */
+  std::vector<cell_type> interpolate(const std::vector<point_type>& points, unsigned int n_threads = 1) const;
+
+private:
+  static constexpr size_t N = sizeof...(AxesTypes);
+
+  /// The knots used along a single axis, with their weights
+  struct AxisWeights {
+    size_t                count;
+    std::array<size_t, 4> indices;
+    std::array<double, 4> weights;
+  };
+
+  const grid_type&                   m_grid;
+  std::array<InterpolationMethod, N> m_methods;
+
+  static std::array<InterpolationMethod, N> linear();
+
+  template <int I>
+  void checkAxes(TemplateLoopCounter<I>) const;
+
+  void checkAxes(TemplateLoopCounter<-1>) const {}
+
+  template <int I>
+  void axesWeights(const point_type& point, std::array<AxisWeights, N>& weights, TemplateLoopCounter<I>) const;
+
+  void axesWeights(const point_type&, std::array<AxisWeights, N>&, TemplateLoopCounter<-1>) const {}
+
+  template <typename T>
+  static void axisWeights(const GridAxis<T>& axis, double value, InterpolationMethod method, AxisWeights& weights);
+
+  template <size_t... Is>
+  typename grid_type::const_reference cell(const std::array<size_t, N>& indices, const IndexList<Is...>&) const;
+
+};  // end of class GridInterpolator
+
+/// Creates a GridInterpolator for the given grid, deducing its type
+template <typename GridCellManager, typename... AxesTypes>
+GridInterpolator<GridCellManager, AxesTypes...>
+makeGridInterpolator(const GridContainer<GridCellManager, AxesTypes...>& grid,
+                     const std::array<InterpolationMethod, sizeof...(AxesTypes)>& methods);
+
+/// Creates a GridInterpolator for the given grid, with multilinear interpolation
+template <typename GridCellManager, typename... AxesTypes>
+GridInterpolator<GridCellManager, AxesTypes...> makeGridInterpolator(const GridContainer<GridCellManager, AxesTypes...>& grid);
+
+}  // end of namespace GridContainer
+}  // end of namespace Euclid
+
+#include "GridContainer/_impl/GridInterpolator.icpp"
+
+#endif /* GRIDCONTAINER_GRIDINTERPOLATOR_H */
@@ -0,0 +1,163 @@
+/*
+ * Copyright (C) 2012-2020 Euclid Science Ground Segment
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+/**
+ * @file GridContainer/GridReduction.h
+ * @date October 19, 2026
+ */
+
+#ifndef GRIDCONTAINER_GRIDREDUCTION_H
+#define GRIDCONTAINER_GRIDREDUCTION_H
+
+#include "GridContainer/GridContainer.h"
+#include "GridContainer/_impl/TemplateLoopCounter.h"
+#include <array>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+namespace Euclid {
+namespace GridContainer {
+
+/// True if the index P is one of the Is
+template <std::size_t P, std::size_t... Is>
+struct IndexListContains : std::false_type {};
+
+template <std::size_t P, std::size_t I, std::size_t... Is>
+struct IndexListContains<P, I, Is...> : std::integral_constant<bool, P == I || IndexListContains<P, Is...>::value> {};
+
+/// Defines type as the IndexList of the positions of the Rest axes (starting at P) which are not reduced
+template <typename Reduced, std::size_t P, typename Kept, typename... Rest>
+struct GridKeptAxes;
+
+template <std::size_t... Is, std::size_t P, std::size_t... Ks>
+struct GridKeptAxes<IndexList<Is...>, P, IndexList<Ks...>> {
+  typedef IndexList<Ks...> type;
+};
+
+template <std::size_t... Is, std::size_t P, std::size_t... Ks, typename Axis, typename... Rest>
+struct GridKeptAxes<IndexList<Is...>, P, IndexList<Ks...>, Axis, Rest...>
+    : GridKeptAxes<IndexList<Is...>, P + 1,
+                   typename std::conditional<IndexListContains<P, Is...>::value, IndexList<Ks...>, IndexList<Ks..., P>>::type,
+                   Rest...> {};
+
+/**
+ * @class GridReducedType
+ *
+ * @brief The type of the grid resulting from the reduction of the axes Is of a grid with the given axes
+ *
+ * @details
+ * The result keeps the other axes, in the same order, and its cells are kept in a vector.
+ *
+ * @tparam CellType the type of the cells of the result
+ * @tparam Reduced an IndexList with the (zero based) indices of the reduced axes
+ */
+template <typename CellType, typename Reduced, typename... AxesTypes>
+class GridReducedType {
+
+  template <typename Kept>
+  struct Grid;
+
+  template <std::size_t... Ks>
+  struct Grid<IndexList<Ks...>> {
+    typedef GridContainer<std::vector<CellType>, typename std::tuple_element<Ks, std::tuple<AxesTypes...>>::type...> type;
+  };
+
+public:
+  /// The positions of the axes which are kept
+  typedef typename GridKeptAxes<Reduced, 0, IndexList<>, AxesTypes...>::type kept_axes;
+
+  /// The type of the reduced grid
+  typedef typename Grid<kept_axes>::type type;
+};
+
+/**
+ * @brief Sums the cells of a grid along the axes Is
+ * @details
+ * The result has all the axes of the grid except the reduced ones, and each of its cells is the
+ * sum of the cells of the grid with the same coordinates on the kept axes. For example, for a grid
+ * with the axes (z, ebv, sed) gridSum<1, 2>(grid) returns a grid with the single axis z.
+ *
+ * The cells are read with the strides of the grid in memory when the GridCellManager keeps them
+ * contiguous (i.e. vectors), and the loop goes along the first axis when it is kept, so the
+ * compiler can vectorize it. Other GridCellManager%s are read cell by cell. The cells of the
+ * result are split between n_threads threads. Slices are supported. If a kept axis has no knots,
+ * the result is empty.
+ *
+ * @tparam Is The (zero based) indices of the axes to reduce. At least one axis must be kept.
+ * @param grid The grid to reduce
+ * @param n_threads Number of threads to use, 1 by default. 0 means one per available core.
+ * @return The reduced grid
+ * @throws Elements::Exception
+ *    if a reduced axis has no knots, and the kept axes do
+ */
+template <std::size_t... Is, typename GridCellManager, typename... AxesTypes>
+typename GridReducedType<typename GridCellManagerTraits<GridCellManager>::data_type, IndexList<Is...>, AxesTypes...>::type
+gridSum(const GridContainer<GridCellManager, AxesTypes...>& grid, unsigned int n_threads = 1);
+
+/**
+ * @brief Integrates the cells of a grid along the axes Is, with the trapezoidal rule
+ * @details
+ * Works as gridSum(), but each cell is weighted by the product, over the reduced axes, of the
+ * trapezoidal weights of its knots: (x[i+1] - x[i-1]) / 2, and half the distance to the next knot
+ * at the borders. This marginalizes a PDF grid over the reduced axes. The knots of the reduced
+ * axes must be arithmetic.
+ *
+ * @throws Elements::Exception
+ *    if a reduced axis has less than two knots
+ */
+template <std::size_t... Is, typename GridCellManager, typename... AxesTypes>
+typename GridReducedType<typename GridCellManagerTraits<GridCellManager>::data_type, IndexList<Is...>, AxesTypes...>::type
+gridIntegrate(const GridContainer<GridCellManager, AxesTypes...>& grid, unsigned int n_threads = 1);
+
+/**
+ * @brief Returns the maximum of the cells of a grid along the axes Is
+ * @details
+ * Works as gridSum(), but each cell of the result is the maximum of the cells, compared
+ * with their operator <.
+ */
+template <std::size_t... Is, typename GridCellManager, typename... AxesTypes>
+typename GridReducedType<typename GridCellManagerTraits<GridCellManager>::data_type, IndexList<Is...>, AxesTypes...>::type
+gridMax(const GridContainer<GridCellManager, AxesTypes...>& grid, unsigned int n_threads = 1);
+
+/**
+ * @brief Returns the position of the maximum of the cells of a grid along the axes Is
+ * @details
+ * Works as gridMax(), but each cell of the result contains the indices of the knots of the
+ * maximum on the reduced axes, in the order of Is. If several cells have the maximum value,
+ * the first one in the iteration order is returned.
+ */
+template <std::size_t... Is, typename GridCellManager, typename... AxesTypes>
+typename GridReducedType<std::array<std::size_t, sizeof...(Is)>, IndexList<Is...>, AxesTypes...>::type
+gridArgmax(const GridContainer<GridCellManager, AxesTypes...>& grid, unsigned int n_threads = 1);
+
+/**
+ * @brief Returns the indices of the maximum cell of a grid
+ * @details
+ * If several cells have the maximum value, the first one in the iteration order is returned.
+ * For a slice, the indices are the ones of the slice, so the fixed axes have the index 0.
+ */
+template <typename GridCellManager, typename... AxesTypes>
+std::array<std::size_t, sizeof...(AxesTypes)> gridArgmaxCell(const GridContainer<GridCellManager, AxesTypes...>& grid);
+
+}  // end of namespace GridContainer
+}  // end of namespace Euclid
+
+#include "GridContainer/_impl/GridReduction.icpp"
+
+#endif /* GRIDCONTAINER_GRIDREDUCTION_H */
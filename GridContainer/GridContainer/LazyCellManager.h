@@ -0,0 +1,236 @@
+/*
+ * Copyright (C) 2012-2020 Euclid Science Ground Segment
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+/**
+ * @file GridContainer/LazyCellManager.h
+ * @date October 19, 2026
+ */
+
+#ifndef GRIDCONTAINER_LAZYCELLMANAGER_H
+#define GRIDCONTAINER_LAZYCELLMANAGER_H
+
+#include "GridContainer/GridContainer.h"
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <tuple>
+#include <unordered_map>
+#include <utility>
+
+namespace Euclid {
+namespace GridContainer {
+
+/// Number of consecutive cells computed together by the LazyCellManager
+constexpr size_t LAZY_BLOCK_CELLS = 64;
+
+/// Default maximum number of cells kept in the cache of a LazyCellManager
+constexpr size_t LAZY_DEFAULT_CACHE_CELLS = 1 << 20;
+
+/**
+ * @class LazyCellManager
+ *
+ * @brief GridCellManager which computes the cells with a function the first time they are accessed
+ *
+ * @details
+ * The cells are grouped in blocks of LAZY_BLOCK_CELLS consecutive cells (in the
+ * iteration order of the grid). When a cell is accessed its whole block is computed,
+ * by calling the function with the position of each cell, and kept in a cache. When
+ * the cache is full, the least recently used block is dropped, and it is computed
+ * again if it is accessed later. The memory then depends on the cache size, instead
+ * of the size of the grid, and only the cells which are used are computed.
+ *
+ * All the accesses are thread safe, and the blocks are computed outside of the lock
+ * of the cache, so several threads (i.e. GridContainer::forEachCell()) compute
+ * different blocks in parallel. A block is computed only once at a time; if the
+ * function throws, the exception is propagated and the block is computed again on
+ * the next access.
+ *
+ * The grids are read-only: the accesses to the cells (the parenthesis operator and the
+ * iterators of the grid) return copies of the cells, as const values, so the cells can
+ * not be modified and a block can be dropped from the cache at any time without
+ * invalidating what was returned. Loops over the cells must then use a value or
+ * `const auto&`.
+ *
+ * @tparam T the type of the cells, which must be default constructible
+ */
+template <typename T>
+class LazyCellManager {
+
+public:
+  typedef T data_type;
+
+  /// The function computing the cell at the given position
+  typedef std::function<T(size_t)> compute_type;
+
+  class iterator;
+
+  /**
+   * @param size The number of cells
+   * @param compute The function computing the cells, called with their position
+   * @param cache_cells The maximum number of cells kept in the cache. It is rounded up
+   *    to a whole number of blocks, with at least one block.
+   */
+  LazyCellManager(size_t size, compute_type compute, size_t cache_cells = LAZY_DEFAULT_CACHE_CELLS);
+
+  /// Returns the number of cells, including the ones not computed
+  size_t size() const;
+
+  /// Returns the maximum number of cells kept in the cache
+  size_t cacheSize() const;
+
+  /// Returns the number of cells currently kept in the cache
+  size_t cachedSize() const;
+
+  /// Returns the number of cells computed so far, including the ones computed again
+  size_t computedCount() const;
+
+  /// Returns true if the block of the cell is in the cache
+  bool isCached(size_t index) const;
+
+  /// Drops all the blocks from the cache
+  void clear();
+
+  iterator begin();
+
+  iterator end();
+
+  /// Returns a copy of the cell at the given index, computing its block if it is not in the cache
+  T operator[](size_t index) const;
+
+private:
+  struct Block;
+
+  typedef std::list<size_t>                                                               lru_type;
+  typedef std::unordered_map<size_t, std::pair<std::shared_ptr<Block>, lru_type::iterator>> cache_type;
+
+  size_t                      m_size;
+  compute_type                m_compute;
+  size_t                      m_max_blocks;
+  mutable std::atomic<size_t> m_computed_count;
+  mutable std::mutex          m_mutex;
+  /// The numbers of the cached blocks, the most recently used first
+  mutable lru_type   m_lru;
+  mutable cache_type m_blocks;
+
+  /// Returns the block with the given number, computed
+  std::shared_ptr<Block> getBlock(size_t number) const;
+};
+
+/**
+ * @class LazyCellManager::iterator
+ *
+ * @brief Iterator through the cells of a LazyCellManager
+ *
+ * @details
+ * The iterator keeps the last block it accessed, so going through consecutive cells
+ * only looks up each block once in the cache. It returns copies of the cells.
+ */
+template <typename T>
+class LazyCellManager<T>::iterator {
+
+public:
+  typedef std::forward_iterator_tag iterator_category;
+  typedef T                         value_type;
+  typedef std::ptrdiff_t            difference_type;
+  typedef const T*                  pointer;
+  typedef const T                   reference;
+
+  iterator(const LazyCellManager<T>& manager, size_t index);
+
+  T operator*() const;
+
+  iterator& operator++();
+
+  iterator& operator+=(difference_type n);
+
+  iterator operator+(difference_type n) const;
+
+  difference_type operator-(const iterator& other) const;
+
+  bool operator==(const iterator& other) const;
+
+  bool operator!=(const iterator& other) const;
+
+private:
+  const LazyCellManager<T>* m_manager;
+  size_t                    m_index;
+  /// The last block accessed, and its number
+  mutable std::shared_ptr<Block> m_block;
+  mutable size_t                 m_block_number;
+};
+
+/**
+ * Specialization of the GridCellManagerTraits for the LazyCellManager. There is
+ * no factory, as the function computing the cells is needed, so the grids must be
+ * created with a LazyCellManager, or with makeLazyGrid(). The cells are accessed
+ * as const values, so the grids are read-only.
+ *
+ * @tparam T the type of the cells
+ */
+template <typename T>
+struct GridCellManagerTraits<LazyCellManager<T>> {
+
+  typedef T data_type;
+
+  typedef typename LazyCellManager<T>::iterator iterator;
+
+  typedef const T reference;
+
+  typedef const T const_reference;
+
+  static size_t size(const LazyCellManager<T>& cell_manager);
+
+  static iterator begin(LazyCellManager<T>& cell_manager);
+
+  static iterator end(LazyCellManager<T>& cell_manager);
+
+  static std::vector<std::pair<size_t, size_t>> nonEmptyRanges(const LazyCellManager<T>& cell_manager);
+
+  static const bool enable_boost_serialize = false;
+};
+
+/**
+ * @brief Creates a grid with the given axes, whose cells are computed by a function when accessed
+ * @details
+ * The function is called with the indices of the cell on each axis, like the
+ * parenthesis operator of the grid, and returns the value of the cell. It may be
+ * called concurrently from several threads. For example:
+ * \code{.cpp}
+ * auto grid = makeLazyGrid<double>(std::make_tuple(sed_axis, z_axis),
+ *                                  [&](size_t sed, size_t z) { return computeFlux(seds[sed], z_axis[z]); });
+ * \endcode
+ *
+ * @tparam T the type of the cells
+ * @param axes The axes of the grid
+ * @param compute The function computing the cells
+ * @param cache_cells The maximum number of cells kept in the cache
+ */
+template <typename T, typename... AxesTypes, typename F>
+GridContainer<LazyCellManager<T>, AxesTypes...> makeLazyGrid(std::tuple<GridAxis<AxesTypes>...> axes, F compute,
+                                                             size_t cache_cells = LAZY_DEFAULT_CACHE_CELLS);
+
+}  // end of namespace GridContainer
+}  // end of namespace Euclid
+
+#include "GridContainer/_impl/LazyCellManager.icpp"
+
+#endif /* GRIDCONTAINER_LAZYCELLMANAGER_H */
@@ -0,0 +1,227 @@
+/*
+ * Copyright (C) 2012-2020 Euclid Science Ground Segment
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+/**
+ * @file GridContainer/NpyCellManager.h
+ * @date October 19, 2026
+ */
+
+#ifndef GRIDCONTAINER_NPYCELLMANAGER_H
+#define GRIDCONTAINER_NPYCELLMANAGER_H
+
+#include "GridContainer/GridContainer.h"
+#include "NdArray/NdArray.h"
+#include "NdArray/io/NpyMmap.h"
+#include <boost/filesystem/path.hpp>
+#include <type_traits>
+
+namespace Euclid {
+namespace GridContainer {
+
+/**
+ * @class NpyCellManager
+ *
+ * @brief GridCellManager keeping the cells in a contiguous NdArray, normally memory mapped from a Npy file
+ *
+ * @details
+ * The cells are arithmetic values, stored in the iteration order of the grid (the first axis changes
+ * faster). A grid using this manager is normally opened with gridNpyImport(), which maps the file
+ * instead of reading it, so opening it does not depend on its size. Grids constructed from their
+ * axes keep the cells in memory. Read-only mappings use the ReadOnlyNpyCellManager instead.
+ *
+ * @tparam T the type of the cells
+ */
+template <typename T>
+class NpyCellManager {
+
+  static_assert(std::is_arithmetic<T>::value, "NpyCellManager only supports arithmetic cells");
+
+public:
+  typedef T  data_type;
+  typedef T* iterator;
+
+  /// Keeps size cells in memory, initialized to zero
+  explicit NpyCellManager(size_t size);
+
+  /**
+   * Keeps the cells of the given array
+   * @param array A contiguous array. It is shared, not copied, so a memory mapped array stays mapped
+   * @throws Elements::Exception
+   *    if the array is not contiguous
+   */
+  explicit NpyCellManager(NdArray::NdArray<T> array);
+
+  /// Returns the number of cells
+  size_t size() const;
+
+  /// Returns a pointer to the first cell
+  iterator begin();
+
+  /// Returns a pointer after the last cell
+  iterator end();
+
+  T& operator[](size_t index);
+
+  const T& operator[](size_t index) const;
+
+  /// Returns the array keeping the cells
+  const NdArray::NdArray<T>& array() const;
+
+private:
+  NdArray::NdArray<T> m_array;
+  T*                  m_data;
+};
+
+/**
+ * @class ReadOnlyNpyCellManager
+ *
+ * @brief GridCellManager keeping the cells in a Npy file mapped without write permission
+ *
+ * @details
+ * The pages of the mapping are shared by all the processes using the same file. As for the
+ * LazyCellManager, its GridCellManagerTraits make the grid return const references to the cells,
+ * even when the grid is not const, so writing to a cell does not compile. A grid using this manager
+ * is opened with gridNpyImportReadOnly().
+ *
+ * @tparam T the type of the cells
+ */
+template <typename T>
+class ReadOnlyNpyCellManager {
+
+  static_assert(std::is_arithmetic<T>::value, "ReadOnlyNpyCellManager only supports arithmetic cells");
+
+public:
+  typedef T        data_type;
+  typedef const T* iterator;
+
+  /**
+   * Keeps the cells of the given array
+   * @param array A contiguous array. It is shared, not copied.
+   * @throws Elements::Exception
+   *    if the array is not contiguous
+   */
+  explicit ReadOnlyNpyCellManager(NdArray::ReadOnlyNdArray<T> array);
+
+  /// Returns the number of cells
+  size_t size() const;
+
+  /// Returns a pointer to the first cell
+  iterator begin() const;
+
+  /// Returns a pointer after the last cell
+  iterator end() const;
+
+  const T& operator[](size_t index) const;
+
+  /// Returns the array keeping the cells
+  const NdArray::ReadOnlyNdArray<T>& array() const;
+
+private:
+  NdArray::ReadOnlyNdArray<T> m_array;
+};
+
+/**
+ * Specialization of the GridCellManagerTraits for the ReadOnlyNpyCellManager. The cells are
+ * returned as const references, so the grids are read-only.
+ *
+ * @tparam T the type of the cells
+ */
+template <typename T>
+struct GridCellManagerTraits<ReadOnlyNpyCellManager<T>> {
+
+  typedef T data_type;
+
+  typedef typename ReadOnlyNpyCellManager<T>::iterator iterator;
+
+  typedef const T& reference;
+
+  typedef const T& const_reference;
+
+  static size_t size(const ReadOnlyNpyCellManager<T>& cell_manager);
+
+  static iterator begin(ReadOnlyNpyCellManager<T>& cell_manager);
+
+  static iterator end(ReadOnlyNpyCellManager<T>& cell_manager);
+
+  static std::vector<std::pair<size_t, size_t>> nonEmptyRanges(const ReadOnlyNpyCellManager<T>& cell_manager);
+
+  static const bool enable_boost_serialize = false;
+};
+
+/// Returns the path of the file keeping the axes of the Npy grid stored at the given path
+boost::filesystem::path gridNpyAxesPath(const boost::filesystem::path& path);
+
+/**
+ * @brief Exports a grid with arithmetic cells as a Npy file
+ * @details
+ * The cells are stored as an array with the shape of the axes in reverse order, so the first
+ * axis is the last dimension (as the first axis changes faster), and the file can be read by
+ * numpy. The axes are stored in a small file next to it, with the path given by
+ * gridNpyAxesPath(), using boost serialization. The cells are written directly into a memory
+ * mapped file, so there is no copy of the whole grid in memory.
+ *
+ * @param path The Npy file to create
+ * @param grid The grid (or slice) to export. Its axes must be boost serializable.
+ */
+template <typename GridCellManager, typename... AxesTypes>
+void gridNpyExport(const boost::filesystem::path& path, const GridContainer<GridCellManager, AxesTypes...>& grid);
+
+/**
+ * @brief Opens a grid exported with gridNpyExport(), memory mapping its cells
+ * @details
+ * Only the axes are read, so opening a grid takes the same time regardless of its size, and the
+ * cells are loaded by the kernel when they are accessed.
+ *
+ * @tparam GridType a GridContainer with a NpyCellManager
+ * @param path The Npy file
+ * @param mode The mapping mode. The default priv mode shares the pages between processes until
+ *    a cell is modified, and the modifications are not written back. readwrite writes them to the
+ *    file. readonly is not accepted, as the grid is writable: use gridNpyImportReadOnly() instead.
+ * @param advice Expected access pattern of the cells, forwarded to the kernel
+ * @return The grid
+ * @throws Elements::Exception
+ *    if the mode is readonly, or the shape of the array does not match the axes
+ */
+template <typename GridType>
+GridType gridNpyImport(const boost::filesystem::path&              path,
+                       boost::iostreams::mapped_file_base::mapmode mode   = boost::iostreams::mapped_file_base::priv,
+                       NdArray::MemoryAdvice                       advice = NdArray::MemoryAdvice::NORMAL);
+
+/**
+ * @brief Opens a grid exported with gridNpyExport(), mapping its cells without write permission
+ * @details
+ * The file is mapped as mmapNpyReadOnly() does, so its pages are shared by all the processes
+ * using it. The cells can only be read, even through a non-const grid.
+ *
+ * @tparam GridType a GridContainer with a ReadOnlyNpyCellManager
+ * @param path The Npy file
+ * @param advice Expected access pattern of the cells, forwarded to the kernel
+ * @return The grid
+ * @throws Elements::Exception
+ *    if the shape of the array does not match the axes
+ */
+template <typename GridType>
+GridType gridNpyImportReadOnly(const boost::filesystem::path& path,
+                               NdArray::MemoryAdvice          advice = NdArray::MemoryAdvice::NORMAL);
+
+}  // end of namespace GridContainer
+}  // end of namespace Euclid
+
+#include "GridContainer/_impl/NpyCellManager.icpp"
+
+#endif /* GRIDCONTAINER_NPYCELLMANAGER_H */
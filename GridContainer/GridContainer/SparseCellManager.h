@@ -0,0 +1,272 @@
+/*
+ * Copyright (C) 2012-2020 Euclid Science Ground Segment
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+/**
+ * @file GridContainer/SparseCellManager.h
+ * @date October 19, 2026
+ */
+
+#ifndef GRIDCONTAINER_SPARSECELLMANAGER_H
+#define GRIDCONTAINER_SPARSECELLMANAGER_H
+
+#include "GridContainer/GridCellManagerTraits.h"
+#include <atomic>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace Euclid {
+namespace GridContainer {
+
+/// Number of consecutive cells stored together by the SparseCellManager
+constexpr size_t SPARSE_BLOCK_CELLS = 64;
+
+/**
+ * @class SparseCellManager
+ *
+ * @brief GridCellManager which only stores the cells which have been written
+ *
+ * @details
+ * The cells are grouped in blocks of SPARSE_BLOCK_CELLS consecutive cells (in the
+ * iteration order of the grid), and only the blocks with at least one written cell
+ * are stored, in a hash map. The memory then scales with the number of written
+ * cells, instead of the size of the grid. The cells which are not stored have the
+ * empty value given to the constructor.
+ *
+ * Reading a cell never stores it. The non-const accesses (the parenthesis operator
+ * or the iterator of a non-const grid) return a SparseCellManager::reference, which
+ * stores the block of the cell only when a value is assigned to it, so the usual
+ * read loops over a non-const grid do not make it dense. As for std::vector<bool>,
+ * such loops must use `auto&&` or a value instead of `auto&`. The cells of a grid
+ * which are actually used can be visited with GridContainer::forEachNonEmptyCell(),
+ * which skips the blocks which are not stored, and prune() releases the blocks which
+ * only contain empty values.
+ *
+ * The blocks are created under a lock, so the cells can be read and written from
+ * several threads (i.e. with GridContainer::forEachCell()). The iterators also remember
+ * the blocks which are not stored until a new block is created, so traversing the
+ * empty parts of the grid does not take the lock for every cell. prune() must not be
+ * called while other threads access the cells.
+ *
+ * @tparam T the type of the cells
+ */
+template <typename T>
+class SparseCellManager {
+
+public:
+  typedef T data_type;
+
+  class reference;
+
+  class iterator;
+
+  /**
+   * Creates a manager without any stored cell
+   * @param size The number of cells
+   * @param empty_value The value of the cells which are not stored
+   */
+  explicit SparseCellManager(size_t size, T empty_value = T());
+
+  /// Returns the number of cells, including the ones not stored
+  size_t size() const;
+
+  /// Returns the number of cells in the stored blocks
+  size_t storedSize() const;
+
+  /// Returns the value of the cells which are not stored
+  const T& emptyValue() const;
+
+  /// Returns true if the block of the cell is stored
+  bool isStored(size_t index) const;
+
+  iterator begin();
+
+  iterator end();
+
+  /// Returns a reference to the cell at the given index, which stores its block when it is assigned
+  reference operator[](size_t index);
+
+  /// Returns the cell at the given index, or the empty value if it is not stored
+  const T& operator[](size_t index) const;
+
+  /// Returns the ranges [first, second) of the positions of the stored cells, in increasing order
+  std::vector<std::pair<size_t, size_t>> storedRanges() const;
+
+  /// Releases the blocks where all the cells are equal to the empty value
+  void prune();
+
+private:
+  size_t                                           m_size;
+  T                                                m_empty_value;
+  std::unordered_map<size_t, std::unique_ptr<T[]>> m_blocks;
+  /// Protects m_blocks, so new blocks can be stored while other threads access the cells
+  mutable std::mutex m_mutex;
+  /// Incremented when a block is stored, so the iterators know when a missing block may have appeared
+  std::atomic<size_t> m_generation;
+
+  /// Returns the block with the given number, or nullptr if it is not stored
+  T* findBlock(size_t block) const;
+
+  /// Returns the block with the given number, storing it if needed
+  T* getBlock(size_t block);
+};
+
+/**
+ * @class SparseCellManager::reference
+ *
+ * @brief Reference to a cell of a SparseCellManager
+ *
+ * @details
+ * It converts to the value of the cell, which is the empty value if the cell is not
+ * stored, and the block of the cell is stored only when a value is assigned to it.
+ */
+template <typename T>
+class SparseCellManager<T>::reference {
+
+public:
+  /// The cell may be given when it is already known to be stored, or missing when its block is known not to be
+  reference(SparseCellManager<T>& manager, size_t index, T* cell = nullptr, bool missing = false);
+
+  reference(const reference&) = default;
+
+  operator const T&() const;
+
+  reference& operator=(const T& value);
+
+  /// Assigns the value of the other cell, as a T& would do
+  reference& operator=(const reference& other);
+
+  template <typename U>
+  reference& operator+=(const U& value);
+
+  template <typename U>
+  reference& operator-=(const U& value);
+
+  template <typename U>
+  reference& operator*=(const U& value);
+
+  template <typename U>
+  reference& operator/=(const U& value);
+
+private:
+  SparseCellManager<T>* m_manager;
+  size_t                m_index;
+  T*                    m_cell;
+  bool                  m_missing;
+
+  /// Returns the cell, storing its block
+  T& cell();
+};
+
+/**
+ * @class SparseCellManager::iterator
+ *
+ * @brief Iterator through the cells of a SparseCellManager
+ *
+ * @details
+ * The iterator keeps the last block it accessed, so going through consecutive cells
+ * only looks up each block once. A block which is not stored is looked up again only
+ * after the manager stores a new block. Dereferencing a non-const iterator returns a
+ * SparseCellManager::reference, while a const iterator returns the cell, or the empty
+ * value for the cells which are not stored. None of them stores the block.
+ */
+template <typename T>
+class SparseCellManager<T>::iterator {
+
+public:
+  typedef std::forward_iterator_tag                      iterator_category;
+  typedef T                                              value_type;
+  typedef std::ptrdiff_t                                 difference_type;
+  typedef const T*                                       pointer;
+  typedef typename SparseCellManager<T>::reference       reference;
+
+  iterator(SparseCellManager<T>& manager, size_t index);
+
+  reference operator*();
+
+  const T& operator*() const;
+
+  const T* operator->() const;
+
+  iterator& operator++();
+
+  iterator& operator+=(difference_type n);
+
+  iterator operator+(difference_type n) const;
+
+  difference_type operator-(const iterator& other) const;
+
+  bool operator==(const iterator& other) const;
+
+  bool operator!=(const iterator& other) const;
+
+private:
+  SparseCellManager<T>* m_manager;
+  size_t                m_index;
+  /// The last block accessed (nullptr if it is not stored), its number, and the generation of the
+  /// manager when it was found missing
+  mutable T*     m_block;
+  mutable size_t m_block_number;
+  mutable size_t m_generation;
+
+  /// Returns the cell if its block is stored, or nullptr
+  T* findCell() const;
+};
+
+/**
+ * Specialization of the GridCellManagerTraits for the SparseCellManager, which
+ * reports only the stored cells as non empty.
+ *
+ * @tparam T the type of the cells
+ */
+template <typename T>
+struct GridCellManagerTraits<SparseCellManager<T>> {
+
+  typedef T data_type;
+
+  typedef typename SparseCellManager<T>::iterator iterator;
+
+  typedef typename SparseCellManager<T>::reference reference;
+
+  typedef const T& const_reference;
+
+  /// Returns a SparseCellManager with the given number of cells, none stored
+  static std::unique_ptr<SparseCellManager<T>> factory(size_t size);
+
+  static size_t size(const SparseCellManager<T>& cell_manager);
+
+  static iterator begin(SparseCellManager<T>& cell_manager);
+
+  static iterator end(SparseCellManager<T>& cell_manager);
+
+  /// Returns the ranges of the stored cells
+  static std::vector<std::pair<size_t, size_t>> nonEmptyRanges(const SparseCellManager<T>& cell_manager);
+
+  static const bool enable_boost_serialize = false;
+};
+
+}  // end of namespace GridContainer
+}  // end of namespace Euclid
+
+#include "GridContainer/_impl/SparseCellManager.icpp"
+
+#endif /* GRIDCONTAINER_SPARSECELLMANAGER_H */
@@ -0,0 +1,214 @@
+/*
+ * Copyright (C) 2012-2020 Euclid Science Ground Segment
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+/**
+ * @file GridContainer/_impl/GridAxisIndex.h
+ * @date October 19, 2026
+ */
+
+#ifndef GRIDCONTAINER_GRIDAXISINDEX_H
+#define GRIDCONTAINER_GRIDAXISINDEX_H
+
+#include "ElementsKernel/Exception.h"
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace Euclid {
+namespace GridContainer {
+
+/// True if std::hash is enabled for T
+template <typename T, typename = void>
+struct IsHashable : std::false_type {};
+
+template <typename T>
+struct IsHashable<T, decltype((void)std::hash<T>{}(std::declval<const T&>()))> : std::true_type {};
+
+/**
+ * @class GridAxisIndex
+ *
+ * @brief Finds the knots of a GridAxis by value
+ *
+ * @details
+ * The strategy is chosen from the type and the knots of the axis:
+ *  - Arithmetic axes with equally spaced increasing knots compute the position of the value (O(1))
+ *  - Arithmetic axes with increasing knots use a binary search (O(log n))
+ *  - Any other axis whose type can be hashed (i.e. std::string) uses a hash map (O(1))
+ *  - Otherwise, the knots are scanned (O(n))
+ *
+ * The index refers to the knots by position, so it stays valid when the axis is moved or copied.
+ * nearest() and bracket() are only available for increasing arithmetic axes.
+ */
+template <typename T, typename = void>
+class GridAxisIndex {
+public:
+  explicit GridAxisIndex(const std::vector<T>&) {}
+
+  /// Position of the first knot equal to value, or values.size() if there is none
+  size_t find(const std::vector<T>& values, const T& value) const {
+    return std::find(values.begin(), values.end(), value) - values.begin();
+  }
+
+  size_t nearest(const std::vector<T>&, const T&) const {
+    throw Elements::Exception() << "Nearest knot lookup requires an axis with increasing numerical knots";
+  }
+
+  std::pair<size_t, size_t> bracket(const std::vector<T>&, const T&) const {
+    throw Elements::Exception() << "Bracketing lookup requires an axis with increasing numerical knots";
+  }
+};
+
+template <typename T>
+class GridAxisIndex<T, typename std::enable_if<!std::is_arithmetic<T>::value && IsHashable<T>::value>::type> {
+public:
+  explicit GridAxisIndex(const std::vector<T>& values) {
+    for (size_t i = 0; i < values.size(); ++i) {
+      // Keep the first occurrence, as std::find would
+      m_positions.emplace(values[i], i);
+    }
+  }
+
+  size_t find(const std::vector<T>& values, const T& value) const {
+    auto position = m_positions.find(value);
+    return (position != m_positions.end()) ? position->second : values.size();
+  }
+
+  size_t nearest(const std::vector<T>&, const T&) const {
+    throw Elements::Exception() << "Nearest knot lookup requires an axis with increasing numerical knots";
+  }
+
+  std::pair<size_t, size_t> bracket(const std::vector<T>&, const T&) const {
+    throw Elements::Exception() << "Bracketing lookup requires an axis with increasing numerical knots";
+  }
+
+private:
+  std::unordered_map<T, size_t> m_positions;
+};
+
+template <typename T>
+class GridAxisIndex<T, typename std::enable_if<std::is_arithmetic<T>::value>::type> {
+public:
+  explicit GridAxisIndex(const std::vector<T>& values) : m_mode(HASHED), m_first(0), m_step(0) {
+    if (std::is_sorted(values.begin(), values.end())) {
+      m_mode = SORTED;
+      if (values.size() > 1 && values.front() < values.back()) {
+        m_first = values.front();
+        m_step  = (static_cast<double>(values.back()) - m_first) / (values.size() - 1);
+        m_mode  = UNIFORM;
+        // The computed position must always be within one knot of the right one
+        for (size_t i = 0; i < values.size() && m_mode == UNIFORM; ++i) {
+          if (std::abs(static_cast<double>(values[i]) - (m_first + i * m_step)) > 1e-6 * m_step) {
+            m_mode = SORTED;
+          }
+        }
+      }
+    } else {
+      for (size_t i = 0; i < values.size(); ++i) {
+        m_positions.emplace(values[i], i);
+      }
+    }
+  }
+
+  size_t find(const std::vector<T>& values, const T& value) const {
+    switch (m_mode) {
+    case UNIFORM: {
+      size_t i = nearestUniform(values, value);
+      return (values[i] == value) ? i : values.size();
+    }
+    case SORTED: {
+      auto i = std::lower_bound(values.begin(), values.end(), value);
+      return (i != values.end() && *i == value) ? i - values.begin() : values.size();
+    }
+    default: {
+      auto position = m_positions.find(value);
+      return (position != m_positions.end()) ? position->second : values.size();
+    }
+    }
+  }
+
+  /// Position of the knot closest to value. Values out of the axis give the first or the last knot.
+  size_t nearest(const std::vector<T>& values, const T& value) const {
+    checkSorted(values);
+    if (m_mode == UNIFORM)
+      return nearestUniform(values, value);
+    size_t upper = std::lower_bound(values.begin(), values.end(), value) - values.begin();
+    if (upper == 0)
+      return 0;
+    if (upper == values.size())
+      return upper - 1;
+    return (value - values[upper - 1] <= values[upper] - value) ? upper - 1 : upper;
+  }
+
+  /// Positions (i, i + 1) of the consecutive knots such that values[i] <= value <= values[i + 1]
+  std::pair<size_t, size_t> bracket(const std::vector<T>& values, const T& value) const {
+    checkSorted(values);
+    if (values.size() < 2 || !(value >= values.front() && value <= values.back())) {
+      throw Elements::Exception() << "Value " << value << " is out of the axis range";
+    }
+    size_t lower;
+    if (m_mode == UNIFORM) {
+      double position = std::floor((value - m_first) / m_step);
+      lower = (position > 0) ? static_cast<size_t>(std::min(position, static_cast<double>(values.size() - 2))) : 0;
+      // Absorb the rounding of the computed position
+      while (lower > 0 && values[lower] > value)
+        --lower;
+      while (lower < values.size() - 2 && values[lower + 1] < value)
+        ++lower;
+    } else {
+      lower = std::upper_bound(values.begin(), values.end() - 1, value) - values.begin();
+      lower = (lower > 0) ? lower - 1 : 0;
+      lower = std::min(lower, values.size() - 2);
+    }
+    return {lower, lower + 1};
+  }
+
+private:
+  enum Mode { UNIFORM, SORTED, HASHED };
+
+  Mode                          m_mode;
+  double                        m_first, m_step;
+  std::unordered_map<T, size_t> m_positions;
+
+  void checkSorted(const std::vector<T>& values) const {
+    if (m_mode == HASHED || values.empty()) {
+      throw Elements::Exception() << "Range lookups require an axis with increasing knots";
+    }
+  }
+
+  size_t nearestUniform(const std::vector<T>& values, const T& value) const {
+    double v        = value;
+    double position = std::round((v - m_first) / m_step);
+    // Clamp before the conversion, which is undefined for infinite and too large values. NaN gives 0.
+    size_t i = (position > 0) ? static_cast<size_t>(std::min(position, static_cast<double>(values.size() - 1))) : 0;
+    // Check the neighbours, as the knots may be only approximately uniform
+    if (i > 0 && std::abs(v - values[i - 1]) < std::abs(v - values[i]))
+      --i;
+    else if (i + 1 < values.size() && std::abs(v - values[i + 1]) < std::abs(v - values[i]))
+      ++i;
+    return i;
+  }
+};
+
+}  // end of namespace GridContainer
+}  // end of namespace Euclid
+
+#endif /* GRIDCONTAINER_GRIDAXISINDEX_H */
@@ -25,6 +25,8 @@
 #ifndef GRIDCONTAINER_TEMPLATELOOPCOUNTER_H
 #define GRIDCONTAINER_TEMPLATELOOPCOUNTER_H
 
+#include <cstddef>
+
 namespace Euclid {
 namespace GridContainer {
 
@@ -33,6 +35,19 @@ namespace GridContainer {
 template <int>
 struct TemplateLoopCounter {};
 
+/// A list of indices, used to expand an array into a parameter pack
+template <std::size_t...>
+struct IndexList {};
+
+/// Defines type as IndexList<0, ..., N - 1>
+template <std::size_t N, std::size_t... Is>
+struct MakeIndexList : MakeIndexList<N - 1, N - 1, Is...> {};
+
+template <std::size_t... Is>
+struct MakeIndexList<0, Is...> {
+  typedef IndexList<Is...> type;
+};
+
 }  // namespace GridContainer
 }  // end of namespace Euclid
 
@@ -0,0 +1,111 @@
+/*
+ * Copyright (C) 2012-2020 Euclid Science Ground Segment
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+/**
+ * @file GridContainer/rawSerialize.h
+ * @date October 19, 2026
+ */
+
+#ifndef GRIDCONTAINER_RAWSERIALIZE_H
+#define GRIDCONTAINER_RAWSERIALIZE_H
+
+#include "GridContainer/GridContainer.h"
+#include <cstdint>
+#include <iostream>
+
+namespace Euclid {
+namespace GridContainer {
+
+/// Version of the raw grid format written by gridRawExport()
+constexpr uint32_t RAW_GRID_VERSION = 1;
+
+/**
+ * @brief Fixed size header of the raw grid format
+ * @details
+ * All the fields are stored with the byte order of the writer, which is identified
+ * by the byte_order field. The header is followed by the axes (a boost text archive,
+ * so they are portable) and by the cells, starting at a multiple of 64 bytes. Raw
+ * cells are followed by a Fletcher-64 checksum of their bytes.
+ */
+struct RawGridHeader {
+  /// Always "ALXGRID", followed by a null character
+  char magic[8];
+  /// Always 0x01020304, as written by the writer
+  uint32_t byte_order;
+  /// Version of the format
+  uint32_t version;
+  /// Code of the cell type: the numpy like code for arithmetic types (i.e. f8), or the
+  /// (truncated) name given by typeid for the others
+  char cell_type[32];
+  /// Size in bytes of each cell, for grids stored as a block of raw cells. 0 for serialized cells.
+  uint64_t cell_size;
+  /// Number of cells
+  uint64_t cell_count;
+  /// Number of cells in each chunk, for serialized cells. 0 for raw cells.
+  uint64_t chunk_cells;
+  /// Size in bytes of the axes archive
+  uint64_t axes_size;
+  /// CRC-32 of the axes archive
+  uint32_t axes_crc;
+  /// CRC-32 of all the fields above
+  uint32_t header_crc;
+};
+
+/**
+ * @brief Exports a grid using the raw grid format
+ * @details
+ * The raw format is much faster than the boost archives used by gridBinaryExport() for
+ * cells which are trivially copyable (i.e. arithmetic types), as they are written as a
+ * single block of memory with the byte order of the machine. Other cells are serialized
+ * with boost, in chunks of cells which are read back one by one, so the file is
+ * never loaded in memory as a whole.
+ *
+ * The header identifies the version, the byte order and the cell type, and contains CRC-32
+ * checksums of itself and of the axes. The cells are followed by their checksum, so
+ * gridRawImport() detects corrupted or truncated files.
+ *
+ * @param out The stream to write the grid in. It must be opened in binary mode.
+ * @param grid The grid (or slice) to export. Its axes must be boost serializable.
+ */
+template <typename GridCellManager, typename... AxesTypes>
+void gridRawExport(std::ostream& out, const GridContainer<GridCellManager, AxesTypes...>& grid);
+
+/**
+ * @brief Imports a grid written by gridRawExport()
+ * @details
+ * Raw cells written with a different byte order are converted. Cells serialized with boost
+ * can only be read with the same byte order.
+ *
+ * @tparam GridType the type of the grid to read from the stream
+ * @param in The stream to read the grid from. It must be opened in binary mode.
+ * @param verify If false, the checksum of the cells is not verified, which saves a
+ *    pass over the data. The header and the axes are always verified.
+ * @return The grid read from the stream
+ * @throws Elements::Exception
+ *    if the stream is not a raw grid, has a newer version, the cell type does not match,
+ *    it is truncated or a checksum does not match
+ */
+template <typename GridType>
+GridType gridRawImport(std::istream& in, bool verify = true);
+
+}  // end of namespace GridContainer
+}  // end of namespace Euclid
+
+#include "GridContainer/_impl/RawSerialize.icpp"
+
+#endif /* GRIDCONTAINER_RAWSERIALIZE_H */
@@ -29,9 +29,11 @@
 #include "GridContainer/serialization/GridContainer.h"
 #include <boost/archive/binary_iarchive.hpp>
 #include <boost/archive/binary_oarchive.hpp>
+#include <array>
 #include <boost/filesystem.hpp>
 #include <iostream>
 #include <memory>
+#include <utility>
 
 namespace Euclid {
 namespace GridContainer {
@@ -135,6 +137,9 @@ GridType gridBinaryImport(std::istream& in) {
  * FITS file is being created, the primary HDU is left empty and the array HDU
  * with the grid data is the first extension.
  *
+ * All the HDUs are written with a single handle of the file, and the cells are
+ * written in groups of rows, so the grid is never copied as a whole.
+ *
  * @param filename The FITS file to store the grid
  * @param hdu_name The name of the array HDU
  * @param grid The grid to store
@@ -157,6 +162,26 @@ void gridFitsExport(const boost::filesystem::path& filename, const std::string&
 template <typename GridType>
 GridType gridFitsImport(const boost::filesystem::path& filename, int hdu_index);
 
+/**
+ * @brief Imports a part of a Grid from a FITS file
+ * @details
+ * Only the cells in the given knot ranges of each axis are read from the file
+ * (with fits_read_subset), so a small part of a big grid can be loaded without
+ * reading the whole array. The axes of the returned grid contain only the knots
+ * in the ranges.
+ *
+ * @param filename The FITS file containing the grid
+ * @param hdu_index The index of the array HDU with the grid data
+ * @param ranges For each axis, the index of the first knot to read and the index
+ *    after the last one
+ * @return The part of the grid
+ * @throws Elements::Exception
+ *    if a range is empty or out of the axis, or the array does not match the axes
+ */
+template <typename GridType>
+GridType gridFitsImport(const boost::filesystem::path& filename, int hdu_index,
+                        const std::array<std::pair<size_t, size_t>, GridType::axisNumber()>& ranges);
+
 }  // end of namespace GridContainer
 }  // end of namespace Euclid
 
@@ -0,0 +1,156 @@
+/*
+ * Copyright (C) 2012-2020 Euclid Science Ground Segment
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+/**
+ * @file src/program/GridIteratorBenchmark.cpp
+ * @date October 19, 2026
+ */
+
+#include "ElementsKernel/ProgramHeaders.h"
+#include "GridContainer/GridContainer.h"
+#include <boost/program_options.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <map>
+#include <limits>
+#include <numeric>
+#include <string>
+
+using boost::program_options::options_description;
+using boost::program_options::value;
+using boost::program_options::variable_value;
+using namespace Euclid::GridContainer;
+
+/// Same layout as a photometry model grid: SED, reddening curve, E(B-V) and redshift
+typedef GridContainer<std::vector<double>, size_t, size_t, double, double> PhotometryGrid;
+
+static GridAxis<double> linearAxis(const std::string& name, size_t size, double step) {
+  std::vector<double> knots(size);
+  for (size_t i = 0; i < size; ++i) {
+    knots[i] = i * step;
+  }
+  return {name, std::move(knots)};
+}
+
+static GridAxis<size_t> indexAxis(const std::string& name, size_t size) {
+  std::vector<size_t> knots(size);
+  std::iota(knots.begin(), knots.end(), 0);
+  return {name, std::move(knots)};
+}
+
+class GridIteratorBenchmark : public Elements::Program {
+
+public:
+  options_description defineSpecificProgramOptions() override {
+    options_description options{};
+    options.add_options()("sed-count", value<size_t>()->default_value(100), "Number of SEDs")(
+        "reddening-curve-count", value<size_t>()->default_value(5), "Number of reddening curves")(
+        "ebv-count", value<size_t>()->default_value(20), "Number of E(B-V) values")(
+        "z-count", value<size_t>()->default_value(600), "Number of redshifts")(
+        "repeat", value<size_t>()->default_value(5), "Number of times each measurement is repeated")(
+        "threads", value<unsigned int>()->default_value(0), "Number of threads of the parallel fill (0 for all the cores)");
+    return options;
+  }
+
+  Elements::ExitCode mainMethod(std::map<std::string, variable_value>& args) override {
+    auto logger = Elements::Logging::getLogger("GridIteratorBenchmark");
+
+    PhotometryGrid grid{indexAxis("SED", args.at("sed-count").as<size_t>()),
+                        indexAxis("Reddening Curve", args.at("reddening-curve-count").as<size_t>()),
+                        linearAxis("E(B-V)", args.at("ebv-count").as<size_t>(), 0.01),
+                        linearAxis("Z", args.at("z-count").as<size_t>(), 0.01)};
+    std::iota(grid.begin(), grid.end(), 0.);
+    logger.info() << "Grid with " << grid.size() << " cells";
+
+    size_t       repeat    = args.at("repeat").as<size_t>();
+    unsigned int n_threads = args.at("threads").as<unsigned int>();
+
+    measure(logger, "Cells", repeat, [&grid]() {
+      double sum = 0;
+      for (auto iter = grid.cbegin(); iter != grid.cend(); ++iter) {
+        sum += *iter;
+      }
+      return sum;
+    });
+
+    measure(logger, "Cells and axes", repeat, [&grid]() {
+      double sum = 0;
+      for (auto iter = grid.cbegin(); iter != grid.cend(); ++iter) {
+        sum += *iter * iter.axisValue<3>() + iter.axisIndex<0>() + iter.axisIndex<1>() + iter.axisValue<2>();
+      }
+      return sum;
+    });
+
+    measure(logger, "Redshift slice", repeat, [&grid]() {
+      double sum   = 0;
+      auto   slice = grid.fixAxisByIndex<3>(grid.getAxis<3>().size() / 2);
+      for (auto iter = slice.begin(); iter != slice.end(); ++iter) {
+        sum += *iter * iter.axisValue<2>();
+      }
+      return sum;
+    });
+
+    measure(logger, "SED slice", repeat, [&grid]() {
+      double sum   = 0;
+      auto   slice = grid.fixAxisByIndex<0>(grid.getAxis<0>().size() / 2).fixAxisByIndex<1>(0);
+      for (auto iter = slice.begin(); iter != slice.end(); ++iter) {
+        sum += *iter * iter.axisValue<3>();
+      }
+      return sum;
+    });
+
+    measure(logger, "Fill", repeat, [&grid]() {
+      for (auto iter = grid.begin(); iter != grid.end(); ++iter) {
+        *iter = model(iter);
+      }
+      return grid(0, 0, 1, 1);
+    });
+
+    measure(logger, "Parallel fill", repeat, [&grid, n_threads]() {
+      grid.forEachCell([](PhotometryGrid::iterator& iter) { *iter = model(iter); }, n_threads);
+      return grid(0, 0, 1, 1);
+    });
+
+    return Elements::ExitCode::OK;
+  }
+
+private:
+  /// Stands for the integration of a SED through a filter
+  static double model(const PhotometryGrid::iterator& iter) {
+    double flux = 0;
+    for (int i = 1; i <= 10; ++i) {
+      flux += std::exp(-iter.axisValue<2>() * i) / (1 + iter.axisValue<3>() * i) * (iter.axisIndex<0>() + 1);
+    }
+    return flux;
+  }
+
+  template <typename F>
+  static void measure(Elements::Logging& logger, const std::string& name, size_t repeat, F&& f) {
+    double                                   checksum = 0;
+    std::chrono::duration<double, std::milli> best{std::numeric_limits<double>::max()};
+    for (size_t i = 0; i < repeat; ++i) {
+      auto start = std::chrono::steady_clock::now();
+      checksum += f();
+      best = std::min<std::chrono::duration<double, std::milli>>(best, std::chrono::steady_clock::now() - start);
+    }
+    logger.info() << name << ": " << best.count() << " ms (checksum " << checksum << ")";
+  }
+};
+
+MAIN_FOR(GridIteratorBenchmark)
@@ -0,0 +1,127 @@
+/*
+ * Copyright (C) 2012-2020 Euclid Science Ground Segment
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+/**
+ * @file src/program/GridSerializeBenchmark.cpp
+ * @date October 19, 2026
+ */
+
+#include "ElementsKernel/ProgramHeaders.h"
+#include "GridContainer/rawSerialize.h"
+#include "GridContainer/serialize.h"
+#include <boost/program_options.hpp>
+#include <boost/serialization/vector.hpp>
+#include <algorithm>
+#include <chrono>
+#include <limits>
+#include <map>
+#include <numeric>
+#include <sstream>
+#include <string>
+
+using boost::program_options::options_description;
+using boost::program_options::value;
+using boost::program_options::variable_value;
+using namespace Euclid::GridContainer;
+
+/// Same layout as a photometry model grid: SED, reddening curve, E(B-V) and redshift
+typedef GridContainer<std::vector<double>, size_t, size_t, double, double> PhotometryGrid;
+
+static GridAxis<double> linearAxis(const std::string& name, size_t size, double step) {
+  std::vector<double> knots(size);
+  for (size_t i = 0; i < size; ++i) {
+    knots[i] = i * step;
+  }
+  return {name, std::move(knots)};
+}
+
+static GridAxis<size_t> indexAxis(const std::string& name, size_t size) {
+  std::vector<size_t> knots(size);
+  std::iota(knots.begin(), knots.end(), 0);
+  return {name, std::move(knots)};
+}
+
+class GridSerializeBenchmark : public Elements::Program {
+
+public:
+  options_description defineSpecificProgramOptions() override {
+    options_description options{};
+    options.add_options()("sed-count", value<size_t>()->default_value(100), "Number of SEDs")(
+        "reddening-curve-count", value<size_t>()->default_value(5), "Number of reddening curves")(
+        "ebv-count", value<size_t>()->default_value(20), "Number of E(B-V) values")(
+        "z-count", value<size_t>()->default_value(600), "Number of redshifts")(
+        "repeat", value<size_t>()->default_value(5), "Number of times each measurement is repeated");
+    return options;
+  }
+
+  Elements::ExitCode mainMethod(std::map<std::string, variable_value>& args) override {
+    auto logger = Elements::Logging::getLogger("GridSerializeBenchmark");
+
+    PhotometryGrid grid{indexAxis("SED", args.at("sed-count").as<size_t>()),
+                        indexAxis("Reddening Curve", args.at("reddening-curve-count").as<size_t>()),
+                        linearAxis("E(B-V)", args.at("ebv-count").as<size_t>(), 0.01),
+                        linearAxis("Z", args.at("z-count").as<size_t>(), 0.01)};
+    std::iota(grid.begin(), grid.end(), 0.);
+    logger.info() << "Grid with " << grid.size() << " cells";
+
+    size_t repeat = args.at("repeat").as<size_t>();
+
+    std::string boost_bytes, raw_bytes;
+    measure(logger, "Boost binary export", repeat, [&grid, &boost_bytes]() {
+      std::ostringstream out{std::ios::binary};
+      gridBinaryExport(out, grid);
+      boost_bytes = out.str();
+      return boost_bytes.size();
+    });
+    measure(logger, "Raw export", repeat, [&grid, &raw_bytes]() {
+      std::ostringstream out{std::ios::binary};
+      gridRawExport(out, grid);
+      raw_bytes = out.str();
+      return raw_bytes.size();
+    });
+    measure(logger, "Boost binary import", repeat, [&boost_bytes]() {
+      std::istringstream in{boost_bytes, std::ios::binary};
+      return gridBinaryImport<PhotometryGrid>(in)(0, 0, 1, 1);
+    });
+    measure(logger, "Raw import", repeat, [&raw_bytes]() {
+      std::istringstream in{raw_bytes, std::ios::binary};
+      return gridRawImport<PhotometryGrid>(in)(0, 0, 1, 1);
+    });
+    measure(logger, "Raw import without checksum", repeat, [&raw_bytes]() {
+      std::istringstream in{raw_bytes, std::ios::binary};
+      return gridRawImport<PhotometryGrid>(in, false)(0, 0, 1, 1);
+    });
+
+    return Elements::ExitCode::OK;
+  }
+
+private:
+  template <typename F>
+  static void measure(Elements::Logging& logger, const std::string& name, size_t repeat, F&& f) {
+    double                                    checksum = 0;
+    std::chrono::duration<double, std::milli> best{std::numeric_limits<double>::max()};
+    for (size_t i = 0; i < repeat; ++i) {
+      auto start = std::chrono::steady_clock::now();
+      checksum += f();
+      best = std::min<std::chrono::duration<double, std::milli>>(best, std::chrono::steady_clock::now() - start);
+    }
+    logger.info() << name << ": " << best.count() << " ms (checksum " << checksum << ")";
+  }
+};
+
+MAIN_FOR(GridSerializeBenchmark)
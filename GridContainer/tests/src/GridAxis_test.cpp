@@ -24,6 +24,7 @@
 
 #include "GridContainer/GridAxis.h"
 #include <boost/test/unit_test.hpp>
+#include <limits>
 
 //-----------------------------------------------------------------------------
 
@@ -251,6 +252,97 @@ BOOST_AUTO_TEST_CASE(equalityOperatorDifferentTypeDifferentSize) {
   BOOST_CHECK(!(axis_2 == axis_1));
 }
 
+//-----------------------------------------------------------------------------
+// Test the lookup by value for the different kinds of axes
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_CASE(findValue) {
+
+  // Given
+  std::vector<double> uniform_knots;
+  for (int i = 0; i <= 600; ++i) {
+    uniform_knots.push_back(i * 0.01);
+  }
+  Euclid::GridContainer::GridAxis<double>      uniform{"Z", uniform_knots};
+  Euclid::GridContainer::GridAxis<double>      sorted{"EBV", {0., 0.01, 0.05, 0.1, 0.3}};
+  Euclid::GridContainer::GridAxis<int>         unsorted{"Curve", {4, 1, 3, 1}};
+  Euclid::GridContainer::GridAxis<std::string> names{"SED", {"Sb", "E", "Irr"}};
+
+  // Then
+  for (size_t i = 0; i < uniform_knots.size(); ++i) {
+    BOOST_CHECK(uniform.find(uniform_knots[i]) == uniform.begin() + i);
+  }
+  BOOST_CHECK(uniform.find(0.015) == uniform.end());
+  BOOST_CHECK(uniform.find(-1.) == uniform.end());
+  BOOST_CHECK(sorted.find(0.05) == sorted.begin() + 2);
+  BOOST_CHECK(sorted.find(0.2) == sorted.end());
+  BOOST_CHECK(unsorted.find(1) == unsorted.begin() + 1);
+  BOOST_CHECK(unsorted.find(2) == unsorted.end());
+  BOOST_CHECK(names.find("Irr") == names.begin() + 2);
+  BOOST_CHECK(names.find("S0") == names.end());
+}
+
+//-----------------------------------------------------------------------------
+// Test the nearest and bracketing knots
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_CASE(nearestAndBracket) {
+
+  // Given
+  Euclid::GridContainer::GridAxis<double> uniform{"Z", {0., 0.5, 1., 1.5, 2.}};
+  Euclid::GridContainer::GridAxis<double> sorted{"EBV", {0., 0.01, 0.05, 0.1, 0.3}};
+  Euclid::GridContainer::GridAxis<int>    unsorted{"Curve", {4, 1, 3}};
+
+  // Then
+  BOOST_CHECK_EQUAL(uniform.nearest(0.7), 1);
+  BOOST_CHECK_EQUAL(uniform.nearest(0.8), 2);
+  BOOST_CHECK_EQUAL(uniform.nearest(-3.), 0);
+  BOOST_CHECK_EQUAL(uniform.nearest(30.), 4);
+  BOOST_CHECK_EQUAL(sorted.nearest(0.02), 1);
+  BOOST_CHECK_EQUAL(sorted.nearest(0.25), 4);
+  BOOST_CHECK_EQUAL(sorted.nearest(1.), 4);
+
+  BOOST_CHECK_EQUAL(uniform.bracket(0.7).first, 1);
+  BOOST_CHECK_EQUAL(uniform.bracket(0.).first, 0);
+  BOOST_CHECK_EQUAL(uniform.bracket(2.).first, 3);
+  BOOST_CHECK_EQUAL(uniform.bracket(1.).first, 2);
+  BOOST_CHECK_EQUAL(sorted.bracket(0.05).first, 2);
+  BOOST_CHECK_EQUAL(sorted.bracket(0.2).first, 3);
+  BOOST_CHECK_EQUAL(sorted.bracket(0.3).first, 3);
+  BOOST_CHECK_EQUAL(sorted.bracket(0.3).second, 4);
+
+  BOOST_CHECK_THROW(uniform.bracket(2.1), Elements::Exception);
+  BOOST_CHECK_THROW(sorted.bracket(-0.1), Elements::Exception);
+  BOOST_CHECK_THROW(unsorted.nearest(2), Elements::Exception);
+  BOOST_CHECK_THROW(unsorted.bracket(2), Elements::Exception);
+}
+
+//-----------------------------------------------------------------------------
+// Test the lookups with values far out of the axis
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_CASE(nearestOutOfRange) {
+
+  // Given
+  Euclid::GridContainer::GridAxis<double> uniform{"Z", {0., 0.5, 1., 1.5, 2.}};
+  Euclid::GridContainer::GridAxis<int>    integers{"Index", {0, 2, 4, 6}};
+  double                                  inf = std::numeric_limits<double>::infinity();
+
+  // Then
+  BOOST_CHECK_EQUAL(uniform.nearest(inf), 4);
+  BOOST_CHECK_EQUAL(uniform.nearest(-inf), 0);
+  BOOST_CHECK_EQUAL(uniform.nearest(1e300), 4);
+  BOOST_CHECK_EQUAL(uniform.nearest(-1e300), 0);
+  BOOST_CHECK_EQUAL(uniform.nearest(std::numeric_limits<double>::quiet_NaN()), 0);
+  BOOST_CHECK_EQUAL(integers.nearest(std::numeric_limits<int>::max()), 3);
+  BOOST_CHECK_EQUAL(integers.nearest(std::numeric_limits<int>::min()), 0);
+  BOOST_CHECK(uniform.find(inf) == uniform.end());
+  BOOST_CHECK(uniform.find(1e300) == uniform.end());
+  BOOST_CHECK(uniform.find(std::numeric_limits<double>::quiet_NaN()) == uniform.end());
+  BOOST_CHECK_THROW(uniform.bracket(inf), Elements::Exception);
+  BOOST_CHECK_THROW(uniform.bracket(std::numeric_limits<double>::quiet_NaN()), Elements::Exception);
+}
+
 //-----------------------------------------------------------------------------
 
 BOOST_AUTO_TEST_SUITE_END()
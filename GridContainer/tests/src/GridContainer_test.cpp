@@ -26,6 +26,7 @@
 #include <ElementsKernel/Real.h>
 #include <boost/test/test_tools.hpp>
 #include <boost/test/unit_test.hpp>
+#include <atomic>
 #include <vector>
 
 using Elements::isEqual;
@@ -1031,6 +1032,146 @@ BOOST_FIXTURE_TEST_CASE(sliceFixAxisNonZeroIndexAccess, GridContainer_Fixture) {
   BOOST_CHECK_THROW(slice.at(0, 0, 0, 1), Elements::Exception);
 }
 
+//-----------------------------------------------------------------------------
+// Test iterating through a slice with several fixed axes
+//-----------------------------------------------------------------------------
+
+BOOST_FIXTURE_TEST_CASE(fixIteratorSeveralAxes, GridContainer_Fixture) {
+
+  // Given
+  GridContainerType grid{axes_tuple};
+  double            value = 0;
+  for (auto& cell : grid) {
+    cell = value++;
+  }
+
+  // When
+  // Starting from (3, 0, 0, 0), the iterator moves forward to (1, 1, 4, 0)
+  auto iterator = grid.begin();
+  ++iterator;
+  ++iterator;
+  ++iterator;
+  iterator.fixAxisByIndex<3>(0).fixAxisByIndex<0>(1).fixAxisByIndex<2>(4);
+
+  // Then
+  for (size_t coord2 = 1; coord2 < axis2.size(); ++coord2) {
+    BOOST_CHECK_EQUAL(iterator.axisIndex<0>(), 1);
+    BOOST_CHECK_EQUAL(iterator.axisIndex<1>(), coord2);
+    BOOST_CHECK_EQUAL(iterator.axisIndex<2>(), 4);
+    BOOST_CHECK_EQUAL(iterator.axisIndex<3>(), 0);
+    BOOST_CHECK_EQUAL(*iterator, grid(1, coord2, 4, 0));
+    ++iterator;
+  }
+  BOOST_CHECK(iterator == grid.end());
+
+  // Moving forward the first axis changes the last one, which is already fixed,
+  // so there are no more cells
+  auto last = grid.begin();
+  for (size_t i = 0; i < total_size / 2 - 1; ++i) {
+    ++last;
+  }
+  last.fixAxisByIndex<3>(0).fixAxisByIndex<0>(1);
+  BOOST_CHECK(last == grid.end());
+}
+
+//-----------------------------------------------------------------------------
+// Test reading the coordinates after iterating without them
+//-----------------------------------------------------------------------------
+
+BOOST_FIXTURE_TEST_CASE(iteratorCoordinatesAfterPlainSteps, GridContainer_Fixture) {
+
+  // Given
+  GridContainerType grid{axes_tuple};
+  auto              iterator = grid.cbegin();
+  size_t            skipped  = axis1.size() * 2 + 1;
+  for (size_t i = 0; i < skipped; ++i) {
+    ++iterator;
+  }
+
+  // Then
+  // The coordinates are computed on the first read, and followed from then on
+  for (size_t i = skipped; i < total_size; ++i, ++iterator) {
+    BOOST_CHECK_EQUAL(iterator.axisIndex<0>(), i % axis1.size());
+    BOOST_CHECK_EQUAL(iterator.axisIndex<3>(), i / (axis1.size() * axis2.size() * axis3.size()));
+  }
+  BOOST_CHECK(iterator == grid.cend());
+}
+
+//-----------------------------------------------------------------------------
+// Test the parallel traversal of all the cells
+//-----------------------------------------------------------------------------
+
+BOOST_FIXTURE_TEST_CASE(forEachCell, GridContainer_Fixture) {
+
+  // Given
+  GridContainerType grid{axes_tuple};
+
+  // When
+  grid.forEachCell(
+      [](GridContainerType::iterator& iter) {
+        *iter = iter.axisValue<0>() * 1000 + iter.axisValue<1>() * 100 + iter.axisValue<2>() * 10 + iter.axisValue<3>();
+      },
+      4);
+
+  // Then
+  for (size_t i = 0; i < axis1.size(); ++i) {
+    for (size_t j = 0; j < axis2.size(); ++j) {
+      for (size_t k = 0; k < axis3.size(); ++k) {
+        for (size_t l = 0; l < axis4.size(); ++l) {
+          BOOST_CHECK_EQUAL(grid(i, j, k, l), axis1[i] * 1000 + axis2[j] * 100 + axis3[k] * 10 + axis4[l]);
+        }
+      }
+    }
+  }
+
+  // The const version visits all the cells too
+  const GridContainerType& const_grid = grid;
+  std::atomic<size_t>      count{0};
+  const_grid.forEachCell(
+      [&count](GridContainerType::const_iterator& iter) {
+        if (*iter == iter.axisValue<0>() * 1000 + iter.axisValue<1>() * 100 + iter.axisValue<2>() * 10 + iter.axisValue<3>())
+          ++count;
+      },
+      3);
+  BOOST_CHECK_EQUAL(count, total_size);
+}
+
+//-----------------------------------------------------------------------------
+// Test the parallel transformation of the cells of a slice
+//-----------------------------------------------------------------------------
+
+BOOST_FIXTURE_TEST_CASE(sliceTransformCells, GridContainer_Fixture) {
+
+  // Given
+  GridContainerType grid{axes_tuple};
+  auto              slice = grid.fixAxisByIndex<1>(2).fixAxisByIndex<3>(1);
+  BOOST_CHECK_EQUAL(slice.size(), axis1.size() * axis3.size());
+
+  // When
+  slice.transformCells(
+      [](const GridContainerType::iterator& iter) {
+        // Boost.Test is not thread safe, so wrong cells are marked and checked later
+        if (iter.axisIndex<1>() != 2 || iter.axisIndex<3>() != 1)
+          return -1.;
+        return iter.axisValue<0>() * 10. + iter.axisValue<2>();
+      },
+      0);
+
+  // Then
+  for (auto iter = grid.begin(); iter != grid.end(); ++iter) {
+    if (iter.axisIndex<1>() == 2 && iter.axisIndex<3>() == 1) {
+      BOOST_CHECK_EQUAL(*iter, iter.axisValue<0>() * 10. + iter.axisValue<2>());
+    } else {
+      BOOST_CHECK_EQUAL(*iter, 0.);
+    }
+  }
+
+  // Exceptions are propagated to the caller
+  BOOST_CHECK_THROW(grid.transformCells(
+                        [](const GridContainerType::iterator&) -> double { throw Elements::Exception() << "Failed"; }, 2),
+                    Elements::Exception);
+}
+
 //-----------------------------------------------------------------------------
 
 BOOST_AUTO_TEST_SUITE_END()
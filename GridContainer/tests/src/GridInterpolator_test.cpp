@@ -0,0 +1,197 @@
+/*
+ * Copyright (C) 2012-2020 Euclid Science Ground Segment
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+/**
+ * @file tests/src/GridInterpolator_test.cpp
+ * @date October 19, 2026
+ */
+
+#include "ElementsKernel/Exception.h"
+#include "GridContainer/GridInterpolator.h"
+#include <boost/test/floating_point_comparison.hpp>
+#include <boost/test/unit_test.hpp>
+
+using namespace Euclid::GridContainer;
+
+typedef GridContainer<std::vector<double>, double, int, double> ScalarGrid;
+typedef GridContainer<std::vector<std::vector<float>>, double, double> VectorGrid;
+
+struct GridInterpolator_Fixture {
+  GridAxis<double> x_axis{"x", {0., 0.5, 1.5, 2., 4.}};
+  GridAxis<int>    y_axis{"y", {-2, 0, 1, 5}};
+  GridAxis<double> z_axis{"z", {10., 20.}};
+
+  static double linear(double x, double y, double z) {
+    return 2 * x + 3 * y - z + 1 + x * y * z / 10;
+  }
+
+  static double cubic(double x, double y, double z) {
+    return x * x * x - 2 * x + y * z;
+  }
+
+  template <typename F>
+  ScalarGrid makeGrid(F f) {
+    ScalarGrid grid{x_axis, y_axis, z_axis};
+    for (auto iter = grid.begin(); iter != grid.end(); ++iter) {
+      *iter = f(iter.axisValue<0>(), iter.axisValue<1>(), iter.axisValue<2>());
+    }
+    return grid;
+  }
+};
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_SUITE(GridInterpolator_test)
+
+//-----------------------------------------------------------------------------
+
+BOOST_FIXTURE_TEST_CASE(knots, GridInterpolator_Fixture) {
+
+  // Given
+  auto grid         = makeGrid(linear);
+  auto interpolator = makeGridInterpolator(grid, {InterpolationMethod::CUBIC, InterpolationMethod::LINEAR,
+                                                  InterpolationMethod::LINEAR});
+
+  // Then
+  for (auto iter = grid.begin(); iter != grid.end(); ++iter) {
+    double value = interpolator({iter.axisValue<0>(), double(iter.axisValue<1>()), iter.axisValue<2>()});
+    BOOST_CHECK_CLOSE(value, *iter, 1e-10);
+  }
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_FIXTURE_TEST_CASE(multilinear, GridInterpolator_Fixture) {
+
+  // Given
+  auto grid         = makeGrid(linear);
+  auto interpolator = makeGridInterpolator(grid);
+
+  // Then
+  // The function is linear along each axis, so the interpolation is exact
+  for (double x : {0., 0.1, 0.7, 1.9, 3.3, 4.}) {
+    for (double y : {-2., -1.5, 0.25, 3.7, 5.}) {
+      for (double z : {10., 12.5, 19.}) {
+        BOOST_CHECK_CLOSE(interpolator({x, y, z}), linear(x, y, z), 1e-10);
+      }
+    }
+  }
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_FIXTURE_TEST_CASE(cubicAxis, GridInterpolator_Fixture) {
+
+  // Given
+  auto grid   = makeGrid(cubic);
+  auto linear = makeGridInterpolator(grid);
+  auto cubic  = makeGridInterpolator(grid, {InterpolationMethod::CUBIC, InterpolationMethod::LINEAR,
+                                           InterpolationMethod::CUBIC});
+
+  // Then
+  // The polynomial along x is exact with four knots, including the borders of the axis.
+  // The axis z has only two knots, so it falls back to linear.
+  for (double x : {0.1, 0.7, 1.9, 3.3}) {
+    BOOST_CHECK_CLOSE(cubic({x, 0.5, 15.}), GridInterpolator_Fixture::cubic(x, 0.5, 15.), 1e-10);
+    BOOST_CHECK_GT(std::abs(linear({x, 0.5, 15.}) - GridInterpolator_Fixture::cubic(x, 0.5, 15.)), 1e-3);
+  }
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_CASE(vectorCells) {
+
+  // Given
+  VectorGrid grid{GridAxis<double>{"x", {0., 1., 2.}}, GridAxis<double>{"y", {0., 10.}}};
+  for (auto iter = grid.begin(); iter != grid.end(); ++iter) {
+    double x = iter.axisValue<0>(), y = iter.axisValue<1>();
+    *iter    = {float(x + y), float(2 * x), float(y)};
+  }
+  auto interpolator = makeGridInterpolator(grid);
+
+  // When
+  auto result = interpolator({1.5, 2.5});
+
+  // Then
+  BOOST_CHECK_EQUAL(result.size(), 3);
+  BOOST_CHECK_CLOSE(result[0], 4.f, 1e-4);
+  BOOST_CHECK_CLOSE(result[1], 3.f, 1e-4);
+  BOOST_CHECK_CLOSE(result[2], 2.5f, 1e-4);
+
+  // Cells must have the same size
+  grid(2, 1).pop_back();
+  BOOST_CHECK_THROW(interpolator({1.5, 2.5}), Elements::Exception);
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_FIXTURE_TEST_CASE(batch, GridInterpolator_Fixture) {
+
+  // Given
+  auto                               grid         = makeGrid(linear);
+  auto                               interpolator = makeGridInterpolator(grid);
+  std::vector<std::array<double, 3>> points;
+  for (size_t i = 0; i < 2000; ++i) {
+    points.push_back({{(i % 41) * 0.1, -2. + (i % 71) * 0.1, 10. + (i % 11)}});
+  }
+
+  // When
+  auto single   = interpolator.interpolate(points);
+  auto parallel = interpolator.interpolate(points, 4);
+
+  // Then
+  BOOST_REQUIRE_EQUAL(single.size(), points.size());
+  for (size_t i = 0; i < points.size(); ++i) {
+    BOOST_CHECK_EQUAL(single[i], parallel[i]);
+    BOOST_CHECK_SMALL(single[i] - linear(points[i][0], points[i][1], points[i][2]), 1e-10);
+  }
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_FIXTURE_TEST_CASE(slice, GridInterpolator_Fixture) {
+
+  // Given
+  auto grid         = makeGrid(linear);
+  auto slice        = grid.fixAxisByValue<2>(20.);
+  auto interpolator = makeGridInterpolator(slice);
+
+  // Then
+  BOOST_CHECK_CLOSE(interpolator({0.7, 2.5, 20.}), linear(0.7, 2.5, 20.), 1e-10);
+  BOOST_CHECK_THROW(interpolator({0.7, 2.5, 15.}), Elements::Exception);
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_FIXTURE_TEST_CASE(invalid, GridInterpolator_Fixture) {
+
+  // Given
+  auto       grid         = makeGrid(linear);
+  auto       interpolator = makeGridInterpolator(grid);
+  ScalarGrid unsorted{GridAxis<double>{"x", {0., 2., 1.}}, y_axis, z_axis};
+
+  // Then
+  BOOST_CHECK_THROW(interpolator({-0.1, 0., 10.}), Elements::Exception);
+  BOOST_CHECK_THROW(interpolator({0., 5.5, 10.}), Elements::Exception);
+  BOOST_CHECK_THROW(interpolator({0., 0., 20.1}), Elements::Exception);
+  BOOST_CHECK_THROW(makeGridInterpolator(unsorted), Elements::Exception);
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,267 @@
+/*
+ * Copyright (C) 2012-2020 Euclid Science Ground Segment
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+/**
+ * @file tests/src/GridReduction_test.cpp
+ * @date October 19, 2026
+ */
+
+#include "ElementsKernel/Exception.h"
+#include "GridContainer/GridReduction.h"
+#include "GridContainer/SparseCellManager.h"
+#include <boost/test/floating_point_comparison.hpp>
+#include <boost/test/unit_test.hpp>
+#include <cmath>
+#include <numeric>
+
+using namespace Euclid::GridContainer;
+
+struct GridReduction_Fixture {
+  typedef GridContainer<std::vector<double>, double, int, double> GridType;
+
+  GridType grid{GridAxis<double>{"X", {0., 1., 2., 3.}}, GridAxis<int>{"Y", {1, 2, 3}},
+                GridAxis<double>{"Z", {0., 0.5, 1.5}}};
+
+  /// The value is different for every cell, and its maximum along Y and Z is at (1, 2) for any X
+  static double value(size_t x, size_t y, size_t z) {
+    return 100. * x - (y - 1.) * (y - 1.) - (z - 2.) * (z - 2.) + 0.1 * y * z;
+  }
+
+  GridReduction_Fixture() {
+    for (size_t x = 0; x < 4; ++x) {
+      for (size_t y = 0; y < 3; ++y) {
+        for (size_t z = 0; z < 3; ++z) {
+          grid(x, y, z) = value(x, y, z);
+        }
+      }
+    }
+  }
+};
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_SUITE(GridReduction_test)
+
+//-----------------------------------------------------------------------------
+
+BOOST_FIXTURE_TEST_CASE(sum, GridReduction_Fixture) {
+
+  // When
+  auto result = gridSum<1, 2>(grid);
+  auto middle = gridSum<1>(grid);
+
+  // Then
+  BOOST_CHECK_EQUAL(result.size(), 4);
+  BOOST_CHECK_EQUAL(result.getAxis<0>().name(), "X");
+  BOOST_CHECK_EQUAL(middle.getAxis<1>().name(), "Z");
+  for (size_t x = 0; x < 4; ++x) {
+    double expected = 0;
+    for (size_t z = 0; z < 3; ++z) {
+      double expected_middle = value(x, 0, z) + value(x, 1, z) + value(x, 2, z);
+      BOOST_CHECK_CLOSE(middle(x, z), expected_middle, 1e-10);
+      expected += expected_middle;
+    }
+    BOOST_CHECK_CLOSE(result(x), expected, 1e-10);
+  }
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_CASE(integrate) {
+
+  // Given
+  std::vector<double> knots;
+  for (size_t i = 0; i <= 200; ++i) {
+    knots.push_back(std::sin(i * M_PI / 400.) * 2.);
+  }
+  GridContainer<std::vector<double>, double, int> grid{GridAxis<double>{"X", knots}, GridAxis<int>{"Y", {1, 2}}};
+  for (auto iter = grid.begin(); iter != grid.end(); ++iter) {
+    *iter = iter.axisValue<1>() * iter.axisValue<0>() * iter.axisValue<0>();
+  }
+
+  // When
+  auto result = gridIntegrate<0>(grid);
+
+  // Then
+  BOOST_CHECK_EQUAL(result.getAxis<0>().name(), "Y");
+  BOOST_CHECK_CLOSE(result(0), 8. / 3., 1e-2);
+  BOOST_CHECK_CLOSE(result(1), 16. / 3., 1e-2);
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_FIXTURE_TEST_CASE(integrateSingleKnot, GridReduction_Fixture) {
+
+  // Given
+  auto slice = grid.fixAxisByIndex<2>(1);
+
+  // Then
+  BOOST_CHECK_THROW(gridIntegrate<2>(slice), Elements::Exception);
+  BOOST_CHECK_NO_THROW(gridIntegrate<1>(slice));
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_FIXTURE_TEST_CASE(maxAndArgmax, GridReduction_Fixture) {
+
+  // When
+  auto max    = gridMax<2, 1>(grid);
+  auto argmax = gridArgmax<2, 1>(grid);
+
+  // Then
+  for (size_t x = 0; x < 4; ++x) {
+    BOOST_CHECK_EQUAL(max(x), value(x, 1, 2));
+    BOOST_CHECK_EQUAL(argmax(x)[0], 2);
+    BOOST_CHECK_EQUAL(argmax(x)[1], 1);
+  }
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_CASE(argmaxUnsortedAxes) {
+
+  // Given
+  typedef GridContainer<std::vector<double>, int, int, int, int> GridType;
+  GridType grid{GridAxis<int>{"A", {0, 1}}, GridAxis<int>{"B", {0, 1, 2}}, GridAxis<int>{"C", {0, 1}},
+                GridAxis<int>{"D", {0, 1, 2, 3}}};
+  std::fill(grid.begin(), grid.end(), 0.);
+  grid(0, 2, 1, 3) = 1.;
+  grid(1, 2, 1, 3) = 2.;
+
+  // When
+  auto argmax_312 = gridArgmax<3, 1, 2>(grid);
+  auto argmax_231 = gridArgmax<2, 3, 1>(grid);
+  auto argmax_123 = gridArgmax<1, 2, 3>(grid);
+
+  // Then
+  for (size_t a = 0; a < 2; ++a) {
+    BOOST_CHECK_EQUAL(argmax_312(a)[0], 3);
+    BOOST_CHECK_EQUAL(argmax_312(a)[1], 2);
+    BOOST_CHECK_EQUAL(argmax_312(a)[2], 1);
+    BOOST_CHECK_EQUAL(argmax_231(a)[0], 1);
+    BOOST_CHECK_EQUAL(argmax_231(a)[1], 3);
+    BOOST_CHECK_EQUAL(argmax_231(a)[2], 2);
+    BOOST_CHECK_EQUAL(argmax_123(a)[0], 2);
+    BOOST_CHECK_EQUAL(argmax_123(a)[1], 1);
+    BOOST_CHECK_EQUAL(argmax_123(a)[2], 3);
+  }
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_FIXTURE_TEST_CASE(argmaxCell, GridReduction_Fixture) {
+
+  // When
+  auto indices       = gridArgmaxCell(grid);
+  auto slice_indices = gridArgmaxCell(grid.fixAxisByIndex<0>(1));
+
+  // Then
+  BOOST_CHECK_EQUAL(indices[0], 3);
+  BOOST_CHECK_EQUAL(indices[1], 1);
+  BOOST_CHECK_EQUAL(indices[2], 2);
+  BOOST_CHECK_EQUAL(slice_indices[0], 0);
+  BOOST_CHECK_EQUAL(slice_indices[2], 2);
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_FIXTURE_TEST_CASE(slice, GridReduction_Fixture) {
+
+  // Given
+  auto slice = grid.fixAxisByIndex<1>(2);
+
+  // When
+  auto result = gridSum<0>(slice);
+
+  // Then
+  BOOST_CHECK_EQUAL(result.getAxis<0>().size(), 1);
+  BOOST_CHECK_EQUAL(result.getAxis<1>().size(), 3);
+  for (size_t z = 0; z < 3; ++z) {
+    BOOST_CHECK_CLOSE(result(0, z), value(0, 2, z) + value(1, 2, z) + value(2, 2, z) + value(3, 2, z), 1e-10);
+  }
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_FIXTURE_TEST_CASE(sparseCells, GridReduction_Fixture) {
+
+  // Given
+  typedef GridContainer<SparseCellManager<double>, double, int, double> SparseGrid;
+  SparseGrid sparse{grid.getAxesTuple(), std::unique_ptr<SparseCellManager<double>>{new SparseCellManager<double>{36, 0.}}};
+  std::copy(grid.begin(), grid.end(), sparse.begin());
+
+  // When
+  auto expected = gridSum<0, 2>(grid);
+  auto result   = gridSum<0, 2>(sparse);
+
+  // Then
+  BOOST_CHECK_EQUAL_COLLECTIONS(result.begin(), result.end(), expected.begin(), expected.end());
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_CASE(threads) {
+
+  // Given
+  std::vector<double> knots(300);
+  std::iota(knots.begin(), knots.end(), 0.);
+  GridContainer<std::vector<double>, double, double, double> grid{GridAxis<double>{"X", knots}, GridAxis<double>{"Y", knots},
+                                                                  GridAxis<double>{"Z", {0., 1., 2., 3., 4.}}};
+  double value = 0;
+  for (auto& cell : grid) {
+    cell = std::fmod(value * 7.3, 11.);
+    ++value;
+  }
+
+  // When
+  auto single   = gridSum<1>(grid, 1);
+  auto parallel = gridSum<1>(grid, 4);
+  auto argmax   = gridArgmax<0, 2>(grid, 4);
+  auto expected = gridArgmax<0, 2>(grid, 1);
+
+  // Then
+  BOOST_CHECK_EQUAL_COLLECTIONS(parallel.begin(), parallel.end(), single.begin(), single.end());
+  BOOST_CHECK(std::equal(argmax.begin(), argmax.end(), expected.begin()));
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_CASE(emptyAxis) {
+
+  // Given
+  typedef GridContainer<std::vector<double>, double, int> GridType;
+  GridType grid{GridAxis<double>{"X", {0., 1., 2.}}, GridAxis<int>{"Y", std::vector<int>{}}};
+
+  // When
+  auto sum    = gridSum<0>(grid);
+  auto max    = gridMax<0>(grid, 4);
+  auto argmax = gridArgmax<0>(grid);
+
+  // Then
+  BOOST_CHECK_EQUAL(sum.size(), 0);
+  BOOST_CHECK_EQUAL(max.size(), 0);
+  BOOST_CHECK_EQUAL(argmax.size(), 0);
+  BOOST_CHECK_THROW(gridSum<1>(grid), Elements::Exception);
+  BOOST_CHECK_THROW(gridMax<1>(grid), Elements::Exception);
+  BOOST_CHECK_THROW(gridArgmax<1>(grid), Elements::Exception);
+  BOOST_CHECK_THROW(gridArgmaxCell(grid), Elements::Exception);
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_SUITE_END()
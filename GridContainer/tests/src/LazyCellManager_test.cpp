@@ -0,0 +1,218 @@
+/*
+ * Copyright (C) 2012-2020 Euclid Science Ground Segment
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+/**
+ * @file tests/src/LazyCellManager_test.cpp
+ * @date October 19, 2026
+ */
+
+#include "ElementsKernel/Exception.h"
+#include "GridContainer/LazyCellManager.h"
+#include <atomic>
+#include <boost/test/unit_test.hpp>
+#include <numeric>
+#include <stdexcept>
+#include <type_traits>
+
+using namespace Euclid::GridContainer;
+
+struct LazyCellManager_Fixture {
+  typedef GridContainer<LazyCellManager<double>, int, double, int> GridType;
+
+  std::tuple<GridAxis<int>, GridAxis<double>, GridAxis<int>> axes{
+      GridAxis<int>{"X", std::vector<int>(40)}, GridAxis<double>{"Y", std::vector<double>(30)},
+      GridAxis<int>{"Z", std::vector<int>(20)}};
+
+  static double value(size_t x, size_t y, size_t z) {
+    return x + 100. * y + 10000. * z;
+  }
+
+  std::shared_ptr<std::atomic<size_t>> calls = std::make_shared<std::atomic<size_t>>(0);
+  LazyCellManager<double>*             manager = nullptr;
+
+  /// Creates the grid with makeLazyGrid()
+  GridType makeGrid(size_t cache_cells = LAZY_DEFAULT_CACHE_CELLS) {
+    auto calls_ptr = calls;
+    return makeLazyGrid<double>(
+        axes,
+        [calls_ptr](size_t x, size_t y, size_t z) {
+          ++*calls_ptr;
+          return value(x, y, z);
+        },
+        cache_cells);
+  }
+
+  /// Creates the grid with a LazyCellManager, which is kept in manager
+  GridType makeGridWithManager(size_t cache_cells) {
+    auto calls_ptr = calls;
+    manager        = new LazyCellManager<double>(
+        24000,
+        [calls_ptr](size_t position) {
+          ++*calls_ptr;
+          return value(position % 40, position / 40 % 30, position / 1200);
+        },
+        cache_cells);
+    return GridType{axes, std::unique_ptr<LazyCellManager<double>>{manager}};
+  }
+};
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_SUITE(LazyCellManager_test)
+
+//-----------------------------------------------------------------------------
+
+BOOST_FIXTURE_TEST_CASE(computedOnAccess, LazyCellManager_Fixture) {
+
+  // Given
+  auto grid = makeGrid();
+
+  // Then
+  BOOST_CHECK_EQUAL(grid.size(), 24000);
+  BOOST_CHECK_EQUAL(*calls, 0);
+  BOOST_CHECK_EQUAL(grid(3, 2, 1), value(3, 2, 1));
+  BOOST_CHECK_EQUAL(grid(4, 2, 1), value(4, 2, 1));
+  BOOST_CHECK_EQUAL(*calls, LAZY_BLOCK_CELLS);
+  BOOST_CHECK_EQUAL(grid.at(39, 29, 19), value(39, 29, 19));
+  BOOST_CHECK_EQUAL(*calls, 2 * LAZY_BLOCK_CELLS);
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_FIXTURE_TEST_CASE(iteration, LazyCellManager_Fixture) {
+
+  // Given
+  auto grid = makeGrid();
+
+  // Then
+  for (auto iter = grid.cbegin(); iter != grid.cend(); ++iter) {
+    BOOST_REQUIRE_EQUAL(*iter, value(iter.axisIndex<0>(), iter.axisIndex<1>(), iter.axisIndex<2>()));
+  }
+  BOOST_CHECK_EQUAL(*calls, grid.size());
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_FIXTURE_TEST_CASE(slice, LazyCellManager_Fixture) {
+
+  // Given
+  auto grid  = makeGrid();
+  auto slice = grid.fixAxisByIndex<1>(7);
+
+  // When
+  size_t count = 0;
+  for (auto iter = slice.begin(); iter != slice.end(); ++iter, ++count) {
+    BOOST_REQUIRE_EQUAL(*iter, value(iter.axisIndex<0>(), 7, iter.axisIndex<2>()));
+  }
+
+  // Then
+  BOOST_CHECK_EQUAL(count, 800);
+  BOOST_CHECK_EQUAL(slice(5, 0, 3), value(5, 7, 3));
+  BOOST_CHECK_LT(*calls, grid.size() / 10);
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_FIXTURE_TEST_CASE(boundedCache, LazyCellManager_Fixture) {
+
+  // Given
+  auto grid = makeGridWithManager(1000);
+  auto sum  = std::accumulate(grid.begin(), grid.end(), 0.);
+
+  // Then
+  BOOST_CHECK_EQUAL(manager->cacheSize(), 16 * LAZY_BLOCK_CELLS);
+  BOOST_CHECK_EQUAL(manager->cachedSize(), manager->cacheSize());
+  BOOST_CHECK(!manager->isCached(0));
+  BOOST_CHECK(manager->isCached(grid.size() - 1));
+
+  // The dropped cells are computed again
+  BOOST_CHECK_EQUAL(std::accumulate(grid.begin(), grid.end(), 0.), sum);
+  BOOST_CHECK_EQUAL(*calls, 2 * grid.size());
+  BOOST_CHECK_EQUAL(manager->computedCount(), 2 * grid.size());
+
+  manager->clear();
+  BOOST_CHECK_EQUAL(manager->cachedSize(), 0);
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_FIXTURE_TEST_CASE(readOnly, LazyCellManager_Fixture) {
+
+  // Given
+  static_assert(std::is_same<GridType::reference, const double>::value, "The cells must be read-only");
+  static_assert(std::is_same<GridType::const_iterator::cell_reference, const double>::value, "The cells must be read-only");
+  auto            grid       = makeGridWithManager(LAZY_BLOCK_CELLS);
+  const GridType& const_grid = grid;
+
+  // When
+  const double& first  = const_grid(0, 0, 0);
+  const auto&   cell   = *grid.begin();
+  const double& second = const_grid(0, 0, 19);
+
+  // Then
+  BOOST_CHECK(!manager->isCached(0));
+  BOOST_CHECK_EQUAL(first + second, value(0, 0, 0) + value(0, 0, 19));
+  BOOST_CHECK_EQUAL(cell, value(0, 0, 0));
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_FIXTURE_TEST_CASE(threads, LazyCellManager_Fixture) {
+
+  // Given
+  auto                grid = makeGridWithManager(4096);
+  std::atomic<size_t> errors{0};
+
+  // When
+  const auto& const_grid = grid;
+  const_grid.forEachCell(
+      [&errors](GridType::const_iterator& iter) {
+        if (*iter != value(iter.axisIndex<0>(), iter.axisIndex<1>(), iter.axisIndex<2>())) {
+          ++errors;
+        }
+      },
+      4);
+
+  // Then
+  BOOST_CHECK_EQUAL(errors, 0);
+  BOOST_CHECK_GE(*calls, grid.size());
+  BOOST_CHECK_LE(manager->cachedSize(), 4096);
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_CASE(failedComputation) {
+
+  // Given
+  bool fail = true;
+  auto grid = makeLazyGrid<int>(std::make_tuple(GridAxis<int>{"X", {1, 2, 3}}), [&fail](size_t x) -> int {
+    if (fail) {
+      throw Elements::Exception() << "Computation failed";
+    }
+    return static_cast<int>(x);
+  });
+
+  // Then
+  BOOST_CHECK_THROW(grid(1), Elements::Exception);
+  fail = false;
+  BOOST_CHECK_EQUAL(grid(1), 1);
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_SUITE_END()
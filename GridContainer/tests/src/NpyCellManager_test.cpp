@@ -0,0 +1,163 @@
+/*
+ * Copyright (C) 2012-2020 Euclid Science Ground Segment
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+/**
+ * @file tests/src/NpyCellManager_test.cpp
+ * @date October 19, 2026
+ */
+
+#include "ElementsKernel/Exception.h"
+#include "ElementsKernel/Temporary.h"
+#include "GridContainer/NpyCellManager.h"
+#include "NdArray/io/Npy.h"
+#include <boost/test/unit_test.hpp>
+#include <numeric>
+
+using namespace Euclid::GridContainer;
+using boost::iostreams::mapped_file_base;
+
+struct NpyCellManager_Fixture {
+  typedef GridContainer<std::vector<float>, int, double, std::string> MemoryGrid;
+  typedef GridContainer<NpyCellManager<float>, int, double, std::string> MappedGrid;
+  typedef GridContainer<ReadOnlyNpyCellManager<float>, int, double, std::string> ReadOnlyGrid;
+
+  Elements::TempDir       dir;
+  boost::filesystem::path path = dir.path() / "grid.npy";
+  MemoryGrid              grid{GridAxis<int>{"Int", {1, 2, 3, 4}}, GridAxis<double>{"Double", {0.1, 0.2, 0.3}},
+                               GridAxis<std::string>{"String", {"a", "b"}}};
+
+  NpyCellManager_Fixture() {
+    std::iota(grid.begin(), grid.end(), 0.f);
+  }
+};
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_SUITE(NpyCellManager_test)
+
+//-----------------------------------------------------------------------------
+
+BOOST_FIXTURE_TEST_CASE(exportImport, NpyCellManager_Fixture) {
+
+  // When
+  gridNpyExport(path, grid);
+  const MappedGrid mapped = gridNpyImport<MappedGrid>(path);
+
+  // Then
+  BOOST_CHECK(boost::filesystem::exists(gridNpyAxesPath(path)));
+  BOOST_CHECK_EQUAL(mapped.size(), grid.size());
+  BOOST_CHECK_EQUAL(mapped.getAxis<1>().name(), "Double");
+  BOOST_CHECK_EQUAL(mapped.getAxis<2>()[1], "b");
+  BOOST_CHECK_EQUAL_COLLECTIONS(mapped.begin(), mapped.end(), grid.begin(), grid.end());
+  BOOST_CHECK_EQUAL(mapped(3, 2, 1), grid(3, 2, 1));
+  BOOST_CHECK_EQUAL(*mapped.fixAxisByValue<2>("b").fixAxisByIndex<0>(1).begin(), grid(1, 0, 1));
+
+  // The array can be read by numpy, with the first axis as the last dimension
+  auto array = Euclid::NdArray::readNpy<float>(path);
+  BOOST_CHECK(array.shape() == std::vector<size_t>({2, 3, 4}));
+  BOOST_CHECK_EQUAL(array.at(1, 2, 3), grid(3, 2, 1));
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_FIXTURE_TEST_CASE(mapModes, NpyCellManager_Fixture) {
+
+  // Given
+  gridNpyExport(path, grid.fixAxisByIndex<2>(1));
+
+  // When
+  {
+    auto copy_on_write = gridNpyImport<MappedGrid>(path, mapped_file_base::priv);
+    copy_on_write(0, 0, 0) = -1;
+  }
+  {
+    // The default mode is copy-on-write, so the grid can be modified
+    auto default_mode = gridNpyImport<MappedGrid>(path);
+    default_mode(3, 2, 0) = -3;
+    BOOST_CHECK_EQUAL(default_mode(3, 2, 0), -3);
+  }
+  {
+    auto writable = gridNpyImport<MappedGrid>(path, mapped_file_base::readwrite);
+    BOOST_CHECK_EQUAL(writable(0, 0, 0), grid(0, 0, 1));
+    writable(1, 1, 0) = -2;
+  }
+
+  // Then
+  const MappedGrid mapped = gridNpyImport<MappedGrid>(path);
+  BOOST_CHECK_EQUAL(mapped.size(), 12);
+  BOOST_CHECK_EQUAL(mapped.getAxis<2>().size(), 1);
+  BOOST_CHECK_EQUAL(mapped(0, 0, 0), grid(0, 0, 1));
+  BOOST_CHECK_EQUAL(mapped(1, 1, 0), -2);
+  BOOST_CHECK_EQUAL(mapped(3, 2, 0), grid(3, 2, 1));
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_FIXTURE_TEST_CASE(readOnly, NpyCellManager_Fixture) {
+
+  // Given
+  gridNpyExport(path, grid);
+
+  // When
+  auto mapped = gridNpyImportReadOnly<ReadOnlyGrid>(path, Euclid::NdArray::MemoryAdvice::SEQUENTIAL);
+
+  // Then
+  // Even through a non-const grid, the cells are const references
+  static_assert(std::is_same<decltype(mapped(0, 0, 0)), const float&>::value, "The cells must be read-only");
+  static_assert(std::is_same<decltype(*mapped.begin()), const float&>::value, "The cells must be read-only");
+  BOOST_CHECK_EQUAL_COLLECTIONS(mapped.begin(), mapped.end(), grid.begin(), grid.end());
+  BOOST_CHECK_EQUAL(mapped(3, 2, 1), grid(3, 2, 1));
+  BOOST_CHECK_EQUAL(*mapped.fixAxisByIndex<1>(2).begin(), grid(0, 2, 0));
+
+  // A writable grid can not be mapped read-only
+  BOOST_CHECK_THROW(gridNpyImport<MappedGrid>(path, mapped_file_base::readonly), Elements::Exception);
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_FIXTURE_TEST_CASE(invalid, NpyCellManager_Fixture) {
+
+  // Given
+  gridNpyExport(path, grid);
+  Euclid::NdArray::writeNpy(path, Euclid::NdArray::NdArray<float>({2, 4, 3}));
+
+  // Then
+  BOOST_CHECK_THROW(gridNpyImport<MappedGrid>(dir.path() / "missing.npy"), Elements::Exception);
+  BOOST_CHECK_THROW(gridNpyImport<MappedGrid>(path), Elements::Exception);
+  BOOST_CHECK_THROW(gridNpyImportReadOnly<ReadOnlyGrid>(path), Elements::Exception);
+  BOOST_CHECK_THROW(MappedGrid(grid.getAxesTuple(), std::unique_ptr<NpyCellManager<float>>{new NpyCellManager<float>(5)}),
+                    Elements::Exception);
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_CASE(inMemory) {
+
+  // When
+  GridContainer<NpyCellManager<double>, int> grid{GridAxis<int>{"Int", {1, 2, 3}}};
+  grid(1) = 5.;
+
+  // Then
+  BOOST_CHECK_EQUAL(grid(0), 0.);
+  BOOST_CHECK_EQUAL(grid(1), 5.);
+  BOOST_CHECK_EQUAL(grid.size(), 3);
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_SUITE_END()
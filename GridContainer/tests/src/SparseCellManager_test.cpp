@@ -0,0 +1,252 @@
+/*
+ * Copyright (C) 2012-2020 Euclid Science Ground Segment
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+/**
+ * @file tests/src/SparseCellManager_test.cpp
+ * @date October 19, 2026
+ */
+
+#include "GridContainer/GridContainer.h"
+#include "GridContainer/SparseCellManager.h"
+#include <boost/test/unit_test.hpp>
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include <vector>
+
+using namespace Euclid::GridContainer;
+
+struct SparseCellManager_Fixture {
+  typedef GridContainer<SparseCellManager<double>, int, int, int> SparseGrid;
+
+  // 1000 x 100 x 10 cells
+  SparseGrid grid{GridAxis<int>{"X", std::vector<int>(1000)}, GridAxis<int>{"Y", std::vector<int>(100)},
+                  GridAxis<int>{"Z", std::vector<int>(10)}};
+
+  SparseCellManager_Fixture() {
+    grid(10, 20, 3)  = 1.;
+    grid(999, 99, 9) = 2.;
+    grid(500, 50, 5) = 3.;
+    grid(501, 50, 5) = 4.;
+  }
+};
+
+/// Counts the cells visited by forEachNonEmptyCell() with a value different from zero
+struct CountNonZero {
+  std::vector<double>& values;
+
+  template <typename Iter>
+  void operator()(Iter& iter) {
+    if (*iter != 0.) {
+      values.push_back(*iter);
+    }
+  }
+};
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_SUITE(SparseCellManager_test)
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_CASE(cellAccess) {
+
+  // Given
+  SparseCellManager<float> manager{200, -1.f};
+  const auto&              const_manager = manager;
+
+  // When
+  manager[70]  = 5.f;
+  manager[199] = 6.f;
+
+  // Then
+  BOOST_CHECK_EQUAL(manager.size(), 200);
+  BOOST_CHECK_EQUAL(const_manager[0], -1.f);
+  BOOST_CHECK_EQUAL(const_manager[64], -1.f);
+  BOOST_CHECK_EQUAL(const_manager[70], 5.f);
+  BOOST_CHECK_EQUAL(const_manager[199], 6.f);
+  BOOST_CHECK(!manager.isStored(0));
+  BOOST_CHECK(manager.isStored(127));
+  // The last block only has 8 cells
+  BOOST_CHECK_EQUAL(manager.storedSize(), 72);
+  manager[130] = 7.f;
+  auto ranges  = manager.storedRanges();
+  BOOST_REQUIRE_EQUAL(ranges.size(), 1);
+  BOOST_CHECK_EQUAL(ranges[0].first, 64);
+  BOOST_CHECK_EQUAL(ranges[0].second, 200);
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_FIXTURE_TEST_CASE(constReadsDoNotStore, SparseCellManager_Fixture) {
+
+  // When
+  const SparseGrid& const_grid = grid;
+  double            sum        = 0;
+  for (auto& cell : const_grid) {
+    sum += cell;
+  }
+  sum += const_grid(0, 0, 0) + const_grid.at(999, 99, 9);
+
+  // Then
+  BOOST_CHECK_EQUAL(sum, 12.);
+  BOOST_CHECK_EQUAL(const_grid.size(), 1000000);
+  std::vector<double> values;
+  const_grid.forEachNonEmptyCell(CountNonZero{values});
+  BOOST_CHECK(values == std::vector<double>({1., 3., 4., 2.}));
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_FIXTURE_TEST_CASE(nonConstReadsDoNotStore, SparseCellManager_Fixture) {
+
+  // Given
+  std::vector<double> before;
+  grid.forEachNonEmptyCell(CountNonZero{before});
+
+  // When
+  double sum = std::accumulate(grid.begin(), grid.end(), 0.);
+  for (auto&& cell : grid) {
+    sum += cell;
+  }
+  sum += grid(0, 0, 0) + grid.at(999, 99, 9);
+  grid(0, 0, 1) += 5.;
+
+  // Then
+  BOOST_CHECK_EQUAL(sum, 22.);
+  BOOST_CHECK_EQUAL(grid(0, 0, 1), 5.);
+  std::vector<double> after;
+  grid.forEachNonEmptyCell(CountNonZero{after});
+  BOOST_CHECK(after == std::vector<double>({5., 1., 3., 4., 2.}));
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_CASE(missingBlockStoredLater) {
+
+  // Given
+  SparseCellManager<float> manager{200, -1.f};
+  const auto&              const_manager = manager;
+  auto                     iter          = manager.begin();
+  auto                     other         = manager.begin();
+  // Reads through the const dereference of the iterator
+  auto read = [](const SparseCellManager<float>::iterator& i) -> float { return *i; };
+  BOOST_CHECK_EQUAL(static_cast<float>(*iter), -1.f);
+  BOOST_CHECK_EQUAL(read(other), -1.f);
+
+  // When
+  manager[1] = 2.f;
+  manager[2] = 3.f;
+  ++iter;
+  ++other;
+  *(iter + 1) = 4.f;
+
+  // Then
+  // The iterators knew the block was missing, but see it once it is stored
+  BOOST_CHECK_EQUAL(static_cast<float>(*iter), 2.f);
+  BOOST_CHECK_EQUAL(read(other), 2.f);
+  BOOST_CHECK_EQUAL(const_manager[2], 4.f);
+  BOOST_CHECK_EQUAL(manager.storedSize(), 64);
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_CASE(parallelWrites) {
+
+  // Given
+  typedef GridContainer<SparseCellManager<double>, int, int> Grid;
+  Grid grid{GridAxis<int>{"X", std::vector<int>(300)}, GridAxis<int>{"Y", std::vector<int>(300)}};
+
+  // When
+  grid.forEachCell(
+      [](Grid::iterator& iter) {
+        if (iter.axisIndex<1>() % 7 == 0) {
+          *iter = iter.axisIndex<0>();
+        }
+      },
+      4);
+
+  // Then
+  const Grid& const_grid = grid;
+  double      sum        = std::accumulate(const_grid.begin(), const_grid.end(), 0.);
+  BOOST_CHECK_EQUAL(sum, 43. * 299. * 300. / 2.);
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_FIXTURE_TEST_CASE(slice, SparseCellManager_Fixture) {
+
+  // When
+  auto                slice = grid.fixAxisByIndex<2>(5).fixAxisByIndex<1>(50);
+  std::vector<double> values;
+  slice.forEachNonEmptyCell(CountNonZero{values});
+  slice(2, 0, 0) = 7.;
+
+  // Then
+  BOOST_CHECK(values == std::vector<double>({3., 4.}));
+  BOOST_CHECK_EQUAL(grid(2, 50, 5), 7.);
+  BOOST_CHECK_EQUAL(*slice.fixAxisByIndex<0>(501).begin(), 4.);
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_CASE(prune) {
+
+  // Given
+  std::unique_ptr<SparseCellManager<double>> manager{new SparseCellManager<double>(10000)};
+  auto&                                      cells = *manager;
+  GridContainer<SparseCellManager<double>, int, int> grid{
+      std::make_tuple(GridAxis<int>{"X", std::vector<int>(100)}, GridAxis<int>{"Y", std::vector<int>(100)}), std::move(manager)};
+
+  // When
+  for (auto iter = grid.begin(); iter != grid.end(); ++iter) {
+    *iter = (iter.axisIndex<1>() == 42) ? 1. : 0.;
+  }
+  size_t stored = cells.storedSize();
+  cells.prune();
+
+  // Then
+  BOOST_CHECK_EQUAL(stored, 10000);
+  // The cells 4200 to 4299 are in the blocks 65 to 67
+  BOOST_CHECK_EQUAL(cells.storedSize(), 192);
+  BOOST_CHECK_EQUAL(grid(5, 42), 1.);
+  BOOST_CHECK_EQUAL(grid(5, 41), 0.);
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_CASE(emptyValue) {
+
+  // Given
+  std::unique_ptr<SparseCellManager<double>> manager{
+      new SparseCellManager<double>(100, std::numeric_limits<double>::quiet_NaN())};
+  GridContainer<SparseCellManager<double>, int> grid{std::make_tuple(GridAxis<int>{"X", std::vector<int>(100)}),
+                                                     std::move(manager)};
+
+  // When
+  grid(3) = 1.;
+
+  // Then
+  BOOST_CHECK(std::isnan(grid(2)));
+  BOOST_CHECK(std::isnan(grid(70)));
+  BOOST_CHECK_EQUAL(grid(3), 1.);
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_SUITE_END()
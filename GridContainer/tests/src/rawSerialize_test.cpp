@@ -0,0 +1,209 @@
+/*
+ * Copyright (C) 2012-2020 Euclid Science Ground Segment
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+/**
+ * @file tests/src/rawSerialize_test.cpp
+ * @date October 19, 2026
+ */
+
+#include "ElementsKernel/Exception.h"
+#include "GridContainer/rawSerialize.h"
+#include <boost/serialization/vector.hpp>
+#include <boost/test/unit_test.hpp>
+#include <cstring>
+#include <numeric>
+#include <sstream>
+
+using namespace Euclid::GridContainer;
+
+struct RawSerialize_Fixture {
+  typedef GridContainer<std::vector<double>, int, double, std::string> GridType;
+
+  GridType          grid{GridAxis<int>{"Int", {1, 2, 3, 4}}, GridAxis<double>{"Double", {0.1, 0.2, 0.3}},
+                              GridAxis<std::string>{"String", {"a", "b"}}};
+  std::stringstream stream{std::ios::in | std::ios::out | std::ios::binary};
+
+  RawSerialize_Fixture() {
+    std::iota(grid.begin(), grid.end(), 0.5);
+  }
+
+  /// Flips one bit of the byte at the given position of the stream
+  void corrupt(size_t position) {
+    auto bytes = stream.str();
+    bytes[position] ^= 1;
+    stream.str(bytes);
+    stream.clear();
+    stream.seekg(0);
+  }
+};
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_SUITE(rawSerialize_test)
+
+//-----------------------------------------------------------------------------
+
+BOOST_FIXTURE_TEST_CASE(rawCells, RawSerialize_Fixture) {
+
+  // When
+  gridRawExport(stream, grid);
+  auto result = gridRawImport<GridType>(stream);
+
+  // Then
+  BOOST_CHECK_EQUAL(result.size(), grid.size());
+  BOOST_CHECK_EQUAL(result.getAxis<0>().name(), "Int");
+  BOOST_CHECK_EQUAL(result.getAxis<1>()[2], 0.3);
+  BOOST_CHECK_EQUAL(result.getAxis<2>()[1], "b");
+  BOOST_CHECK_EQUAL_COLLECTIONS(result.begin(), result.end(), grid.begin(), grid.end());
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_FIXTURE_TEST_CASE(slice, RawSerialize_Fixture) {
+
+  // Given
+  auto slice = grid.fixAxisByIndex<1>(2).fixAxisByIndex<2>(1);
+
+  // When
+  gridRawExport(stream, slice);
+  auto result = gridRawImport<GridType>(stream);
+
+  // Then
+  BOOST_CHECK_EQUAL(result.size(), 4);
+  BOOST_CHECK_EQUAL(result.getAxis<1>().size(), 1);
+  BOOST_CHECK_EQUAL_COLLECTIONS(result.begin(), result.end(), slice.begin(), slice.end());
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_FIXTURE_TEST_CASE(contiguousSlice, RawSerialize_Fixture) {
+
+  // Given
+  auto slice = grid.fixAxisByIndex<2>(1);
+
+  // When
+  gridRawExport(stream, slice);
+  auto result = gridRawImport<GridType>(stream);
+
+  // Then
+  BOOST_CHECK_EQUAL(result.size(), 12);
+  BOOST_CHECK_EQUAL(result.getAxis<2>()[0], "b");
+  BOOST_CHECK_EQUAL_COLLECTIONS(result.begin(), result.end(), slice.begin(), slice.end());
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_CASE(serializedCells) {
+
+  // Given
+  typedef GridContainer<std::vector<std::vector<double>>, int, int> VectorGrid;
+  VectorGrid        grid{GridAxis<int>{"X", std::vector<int>(100)}, GridAxis<int>{"Y", std::vector<int>(50)}};
+  std::stringstream stream{std::ios::in | std::ios::out | std::ios::binary};
+  double            value = 0;
+  for (auto& cell : grid) {
+    cell.assign(static_cast<size_t>(value) % 4, value);
+    ++value;
+  }
+
+  // When
+  gridRawExport(stream, grid);
+  auto result = gridRawImport<VectorGrid>(stream);
+
+  // Then
+  BOOST_CHECK_EQUAL(result.size(), 5000);
+  BOOST_CHECK(std::equal(result.begin(), result.end(), grid.begin()));
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_FIXTURE_TEST_CASE(corrupted, RawSerialize_Fixture) {
+
+  // Given
+  gridRawExport(stream, grid);
+  auto size = stream.str().size();
+
+  // Then
+  corrupt(size - 10);
+  BOOST_CHECK_THROW(gridRawImport<GridType>(stream), Elements::Exception);
+  stream.clear();
+  stream.seekg(0);
+  BOOST_CHECK_NO_THROW(gridRawImport<GridType>(stream, false));
+
+  corrupt(size - 10);
+  corrupt(offsetof(RawGridHeader, cell_count));
+  BOOST_CHECK_THROW(gridRawImport<GridType>(stream), Elements::Exception);
+
+  corrupt(offsetof(RawGridHeader, cell_count));
+  corrupt(sizeof(RawGridHeader) + 5);
+  BOOST_CHECK_THROW(gridRawImport<GridType>(stream), Elements::Exception);
+
+  corrupt(sizeof(RawGridHeader) + 5);
+  stream.str(stream.str().substr(0, size - 20));
+  stream.clear();
+  BOOST_CHECK_THROW(gridRawImport<GridType>(stream), Elements::Exception);
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_CASE(invalidChunks) {
+
+  // Given
+  typedef GridContainer<std::vector<std::vector<double>>, int> VectorGrid;
+  VectorGrid        grid{GridAxis<int>{"X", {1, 2, 3}}};
+  std::stringstream stream{std::ios::in | std::ios::out | std::ios::binary};
+  gridRawExport(stream, grid);
+  auto          bytes = stream.str();
+  RawGridHeader header;
+  std::memcpy(&header, bytes.data(), sizeof(header));
+  size_t chunk_offset = (sizeof(header) + header.axes_size + RAW_GRID_ALIGNMENT - 1) / RAW_GRID_ALIGNMENT * RAW_GRID_ALIGNMENT;
+
+  // Then
+  // A chunk without cells would never reach the end of the grid
+  RawGridHeader no_cells = header;
+  no_cells.chunk_cells   = 0;
+  no_cells.header_crc    = rawGridHeaderCrc(no_cells);
+  std::stringstream no_cells_stream{bytes.replace(0, sizeof(header), reinterpret_cast<const char*>(&no_cells), sizeof(header))};
+  BOOST_CHECK_THROW(gridRawImport<VectorGrid>(no_cells_stream), Elements::Exception);
+
+  // The size of the chunk is checked before allocating it
+  uint64_t huge_size = uint64_t{1} << 60;
+  bytes              = stream.str();
+  bytes.replace(chunk_offset, sizeof(huge_size), reinterpret_cast<const char*>(&huge_size), sizeof(huge_size));
+  std::stringstream huge_stream{bytes};
+  BOOST_CHECK_THROW(gridRawImport<VectorGrid>(huge_stream), Elements::Exception);
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_FIXTURE_TEST_CASE(invalid, RawSerialize_Fixture) {
+
+  // Given
+  gridRawExport(stream, grid);
+
+  // Then
+  BOOST_CHECK_THROW((gridRawImport<GridContainer<std::vector<float>, int, double, std::string>>(stream)),
+                    Elements::Exception);
+  corrupt(0);
+  BOOST_CHECK_THROW(gridRawImport<GridType>(stream), Elements::Exception);
+  std::stringstream empty;
+  BOOST_CHECK_THROW(gridRawImport<GridType>(empty), Elements::Exception);
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -22,6 +22,7 @@
  * @author Nikolaos Apostolakos
  */
 
+#include "ElementsKernel/Exception.h"
 #include "ElementsKernel/Temporary.h"
 #include "GridContainer/serialize.h"
 #include "serialization/DefaultConstructibleClass.h"
@@ -248,6 +249,46 @@ BOOST_AUTO_TEST_CASE(GridContainerSerializationFits) {
   BOOST_CHECK_EQUAL_COLLECTIONS(result2.begin(), result2.end(), grid2.begin(), grid2.end());
 }
 
+//-----------------------------------------------------------------------------
+// Test reading a part of a grid from a FITS file
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_CASE(GridContainerSerializationFitsSubset) {
+
+  using namespace Euclid::GridContainer;
+  typedef GridContainer<std::vector<float>, int, double, int> GridContainerType;
+
+  // Given
+  GridAxis<int>     axis1{"First", {1, 2, 3, 4, 5}};
+  GridAxis<double>  axis2{"Second", {0.1, 0.2, 0.3, 0.4}};
+  GridAxis<int>     axis3{"Third", {10, 20, 30}};
+  GridContainerType grid{axis1, axis2, axis3};
+  float             value = 0;
+  for (auto& cell : grid) {
+    cell = value++;
+  }
+  Elements::TempDir dir{};
+  auto              fits_file = dir.path() / "test.fits";
+  gridFitsExport(fits_file, "grid", grid);
+
+  // When
+  auto result = gridFitsImport<GridContainerType>(fits_file, 1, {{{1, 4}, {2, 3}, {0, 3}}});
+
+  // Then
+  BOOST_CHECK_EQUAL(result.size(), 9);
+  BOOST_CHECK_EQUAL(result.getAxis<0>().name(), "First");
+  BOOST_CHECK_EQUAL(result.getAxis<0>()[0], 2);
+  BOOST_CHECK_EQUAL(result.getAxis<1>().size(), 1);
+  BOOST_CHECK_EQUAL(result.getAxis<1>()[0], 0.3);
+  for (size_t i = 0; i < 3; ++i) {
+    for (size_t k = 0; k < 3; ++k) {
+      BOOST_CHECK_EQUAL(result(i, 0, k), grid(i + 1, 2, k));
+    }
+  }
+  BOOST_CHECK_THROW((gridFitsImport<GridContainerType>(fits_file, 1, {{{0, 6}, {0, 1}, {0, 1}}})), Elements::Exception);
+  BOOST_CHECK_THROW((gridFitsImport<GridContainerType>(fits_file, 1, {{{2, 2}, {0, 1}, {0, 1}}})), Elements::Exception);
+}
+
 //-----------------------------------------------------------------------------
 
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,132 @@
+/*
+ * Copyright (C) 2012-2020 Euclid Science Ground Segment
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+/**
+ * @file NdArray/AlignedContainer.h
+ * @date October 18, 2026
+ */
+
+#ifndef ALEXANDRIA_NDARRAY_ALIGNEDCONTAINER_H
+#define ALEXANDRIA_NDARRAY_ALIGNEDCONTAINER_H
+
+#include "NdArray/NdArray.h"
+#include <cstdlib>
+#include <memory>
+#include <type_traits>
+
+namespace Euclid {
+namespace NdArray {
+
+/**
+ * A container that can be used by NdArray, and whose memory is aligned to a given boundary.
+ * Optionally, the last axis can be padded so every row starts on an aligned address, which allows
+ * SIMD kernels to use aligned loads and stores for every row.
+ * @tparam T
+ *  Contained value type. It must be trivially copyable.
+ */
+template <typename T>
+class AlignedContainer {
+public:
+  static_assert(std::is_trivially_copyable<T>::value, "AlignedContainer only supports trivially copyable types");
+
+  /**
+   * Constructor
+   * @param shape
+   *    Shape of the NdArray that will be stored
+   * @param alignment
+   *    Alignment, in bytes, of the first element. Must be a power of two multiple of sizeof(void*)
+   * @param simd_width
+   *    If not 0, the size in bytes of the last axis is padded to a multiple of this value
+   * @throws std::invalid_argument
+   *    If the alignment is not valid, or simd_width is not a multiple of sizeof(T)
+   */
+  explicit AlignedContainer(const std::vector<size_t>& shape, size_t alignment = 64, size_t simd_width = 0);
+
+  /// Deep copy
+  AlignedContainer(const AlignedContainer& other);
+
+  /// Move constructor
+  AlignedContainer(AlignedContainer&&) = default;
+
+  size_t size() const {
+    return m_size;
+  }
+
+  T* data() {
+    return m_data.get();
+  }
+
+  const T* data() const {
+    return m_data.get();
+  }
+
+  /// Number of elements reserved for a row of row_size elements
+  size_t paddedRowSize(size_t row_size) const;
+
+  /// Resize for the given shape, preserving the content of the rows already present
+  void resize(const std::vector<size_t>& shape);
+
+  /// Alignment in bytes
+  size_t alignment() const {
+    return m_alignment;
+  }
+
+private:
+  struct Deleter {
+    void operator()(T* ptr) const {
+      std::free(ptr);
+    }
+  };
+
+  size_t                        m_alignment, m_row_multiple, m_size;
+  std::unique_ptr<T[], Deleter> m_data;
+
+  /// Compute the number of elements required for the given shape
+  size_t requiredSize(const std::vector<size_t>& shape) const;
+
+  /// Allocate n zero-initialized elements
+  std::unique_ptr<T[], Deleter> allocate(size_t n) const;
+};
+
+/**
+ * Create an NdArray whose storage is aligned, and optionally padded, for vectorized access
+ * @tparam T
+ *  NdArray cell type
+ * @param shape
+ *  NdArray shape
+ * @param alignment
+ *  Alignment, in bytes, of the first element
+ * @param simd_width
+ *  If not 0, the size in bytes of the last axis is padded to a multiple of this value, so every row is aligned
+ *  as long as simd_width is a multiple of alignment
+ * @return
+ *  A new NdArray
+ */
+template <typename T>
+NdArray<T> createAligned(const std::vector<size_t>& shape, size_t alignment = 64, size_t simd_width = 0) {
+  return {shape, AlignedContainer<T>(shape, alignment, simd_width)};
+}
+
+}  // end of namespace NdArray
+}  // end of namespace Euclid
+
+#define ALIGNEDCONTAINER_IMPL
+#include "NdArray/_impl/AlignedContainer.icpp"
+#undef ALIGNEDCONTAINER_IMPL
+
+#endif  // ALEXANDRIA_NDARRAY_ALIGNEDCONTAINER_H
@@ -0,0 +1,130 @@
+/*
+ * Copyright (C) 2012-2020 Euclid Science Ground Segment
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+/**
+ * @file NdArray/Compare.h
+ * @date October 19, 2026
+ */
+
+#ifndef ALEXANDRIA_NDARRAY_COMPARE_H
+#define ALEXANDRIA_NDARRAY_COMPARE_H
+
+#include "NdArray/NdArray.h"
+#include <cstdint>
+
+namespace Euclid {
+namespace NdArray {
+
+/**
+ * When two values are considered equal by compare
+ */
+struct Tolerance {
+  enum Mode { EXACT, ULPS, RELATIVE };
+
+  Mode     mode;
+  double   relative;
+  double   absolute;
+  uint64_t max_ulps;
+  bool     nan_equal;
+
+  /**
+   * Values must be equal
+   * @param nan_equal
+   *    If true, NaN is considered equal to NaN
+   */
+  static Tolerance exact(bool nan_equal = false) {
+    return {EXACT, 0., 0., 0, nan_equal};
+  }
+
+  /**
+   * Values must be at most n representable floating point values apart, which is a relative tolerance that
+   * does not depend on the magnitude. For integers, this is the absolute difference.
+   */
+  static Tolerance ulps(uint64_t n, bool nan_equal = false) {
+    return {ULPS, 0., 0., n, nan_equal};
+  }
+
+  /**
+   * Values must satisfy |a - b| <= max(absolute, relative * max(|a|, |b|)). The absolute tolerance
+   * is useful when the values are close to zero.
+   */
+  static Tolerance relativeTo(double relative, double absolute = 0., bool nan_equal = false) {
+    return {RELATIVE, relative, absolute, 0, nan_equal};
+  }
+};
+
+/**
+ * Result of an element-wise comparison
+ */
+struct Comparison {
+  /// False if the shapes are different, in which case the content is not compared
+  bool same_shape;
+
+  /// Number of elements that are not equal. If the comparison stopped at the first mismatch, it is only
+  /// guaranteed not to be 0 when there is some.
+  size_t mismatches;
+
+  /// Coordinates of the first element (in row-major order) that is not equal. Empty if there is none.
+  std::vector<size_t> first_mismatch;
+
+  /// True if the shapes and all the elements are equal
+  explicit operator bool() const {
+    return same_shape && mismatches == 0;
+  }
+};
+
+/**
+ * Compare two arrays element by element
+ * @details
+ *  Contiguous arrays are compared directly over their memory, by blocks, counting the mismatches without branching so
+ *  the compiler can vectorize the inner loop. The array is split between threads, and when stop_at_first is set,
+ *  they stop as soon as the first mismatch is known, without scanning the rest of the array.
+ * @param a
+ *  First array
+ * @param b
+ *  Second array
+ * @param tolerance
+ *  When two values are considered equal. Only exact comparisons are supported for non arithmetic types.
+ * @param n_threads
+ *  Number of threads to use. 0 means one per available core.
+ * @param stop_at_first
+ *  If true, the comparison stops once the first mismatch is found, so the count of mismatches is not complete
+ * @return
+ *  The number of mismatches, and the coordinates of the first one
+ */
+template <typename T>
+Comparison compare(const NdArray<T>& a, const NdArray<T>& b, const Tolerance& tolerance = Tolerance::exact(),
+                   unsigned int n_threads = 1, bool stop_at_first = false);
+
+/**
+ * @return
+ *  true if both arrays have the same shape, and all their elements satisfy
+ *  |a - b| <= max(absolute, relative * max(|a|, |b|))
+ */
+template <typename T>
+bool allClose(const NdArray<T>& a, const NdArray<T>& b, double relative = 1e-9, double absolute = 0.,
+              unsigned int n_threads = 1);
+
+}  // end of namespace NdArray
+}  // end of namespace Euclid
+
+#define COMPARE_IMPL
+#include "NdArray/_impl/Compare.icpp"
+#undef COMPARE_IMPL
+
+#endif  // ALEXANDRIA_NDARRAY_COMPARE_H
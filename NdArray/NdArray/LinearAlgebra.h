@@ -0,0 +1,153 @@
+/*
+ * Copyright (C) 2012-2020 Euclid Science Ground Segment
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+/**
+ * @file NdArray/LinearAlgebra.h
+ * @date October 19, 2026
+ */
+
+#ifndef ALEXANDRIA_NDARRAY_LINEARALGEBRA_H
+#define ALEXANDRIA_NDARRAY_LINEARALGEBRA_H
+
+#include "NdArray/NdArray.h"
+
+namespace Euclid {
+namespace NdArray {
+
+/**
+ * General matrix multiplication, C = alpha * A * B + beta * C
+ * @details
+ *  The product is computed by cache sized blocks, packing the operands so the inner kernel runs over contiguous
+ *  memory and can be vectorized by the compiler. The operands can have any memory layout, so transposed views
+ *  (NdArray::transpose) are used directly, without copying them first.
+ * @tparam T
+ *  float or double
+ * @param alpha
+ *  Scale factor for the product
+ * @param a
+ *  Matrix of shape (m, k)
+ * @param b
+ *  Matrix of shape (k, n)
+ * @param beta
+ *  Scale factor for the initial content of C. If 0, C is overwritten, even if it contains NaN.
+ * @param c
+ *  Matrix of shape (m, n). It must not overlap with A or B.
+ * @param n_threads
+ *  Number of threads to use. 0 means one per available core. Small products always run on the calling thread.
+ * @throws std::length_error
+ *  If the shapes of the operands are not compatible
+ */
+template <typename T>
+void gemm(T alpha, const NdArray<T>& a, const NdArray<T>& b, T beta, NdArray<T>& c, unsigned int n_threads = 1);
+
+/**
+ * Matrix product
+ * @param a
+ *  Matrix of shape (m, k)
+ * @param b
+ *  Matrix of shape (k, n)
+ * @param n_threads
+ *  Number of threads to use. 0 means one per available core.
+ * @return
+ *  A new matrix of shape (m, n)
+ * @throws std::length_error
+ *  If the shapes of the operands are not compatible
+ */
+template <typename T>
+NdArray<T> matmul(const NdArray<T>& a, const NdArray<T>& b, unsigned int n_threads = 1);
+
+/**
+ * General matrix-vector multiplication, y = alpha * A * x + beta * y
+ * @tparam T
+ *  float or double
+ * @param alpha
+ *  Scale factor for the product
+ * @param a
+ *  Matrix of shape (m, n)
+ * @param x
+ *  Vector of shape (n)
+ * @param beta
+ *  Scale factor for the initial content of y. If 0, y is overwritten, even if it contains NaN.
+ * @param y
+ *  Vector of shape (m). It must not overlap with A or x.
+ * @param n_threads
+ *  Number of threads to use. 0 means one per available core.
+ * @throws std::length_error
+ *  If the shapes of the operands are not compatible
+ */
+template <typename T>
+void gemv(T alpha, const NdArray<T>& a, const NdArray<T>& x, T beta, NdArray<T>& y, unsigned int n_threads = 1);
+
+/**
+ * Matrix-vector product
+ * @param a
+ *  Matrix of shape (m, n)
+ * @param x
+ *  Vector of shape (n)
+ * @param n_threads
+ *  Number of threads to use. 0 means one per available core.
+ * @return
+ *  A new vector of shape (m)
+ */
+template <typename T>
+NdArray<T> matvec(const NdArray<T>& a, const NdArray<T>& x, unsigned int n_threads = 1);
+
+/**
+ * Cholesky decomposition, in place, of a batch of small symmetric positive definite matrices.
+ * On return, the lower triangle of each matrix contains L, so A = L * L^T, and the upper triangle is set to 0.
+ * Only the lower triangle of the input is used.
+ * @param a
+ *  Array of shape (batch, n, n), or a single matrix of shape (n, n)
+ * @param n_threads
+ *  Number of threads to use. 0 means one per available core.
+ * @return
+ *  The number of matrices that are not positive definite. They are filled with NaN, so a single
+ *  degenerate matrix does not abort the whole batch.
+ * @throws std::length_error
+ *  If the matrices are not square
+ */
+template <typename T>
+size_t choleskyBatch(NdArray<T>& a, unsigned int n_threads = 1);
+
+/**
+ * Solve a batch of small linear least squares problems, minimizing |A x - b|^2 for each pair (A, b).
+ * The normal equations are solved with a Cholesky decomposition, which is accurate enough for the well conditioned
+ * problems found, for instance, when fitting a handful of templates to the photometry of each source.
+ * @param a
+ *  Design matrices, with shape (batch, m, n), or a single one of shape (m, n)
+ * @param b
+ *  Observations, with shape (batch, m), or (m) for a single problem
+ * @param n_threads
+ *  Number of threads to use. 0 means one per available core.
+ * @return
+ *  The solutions, with shape (batch, n), or (n) for a single problem. Problems whose normal matrix is
+ *  not positive definite (i.e. rank deficient design matrices) get a solution filled with NaN.
+ * @throws std::length_error
+ *  If the shapes of the operands are not compatible
+ */
+template <typename T>
+NdArray<T> leastSquaresBatch(const NdArray<T>& a, const NdArray<T>& b, unsigned int n_threads = 1);
+
+}  // end of namespace NdArray
+}  // end of namespace Euclid
+
+#define LINEARALGEBRA_IMPL
+#include "NdArray/_impl/LinearAlgebra.icpp"
+#undef LINEARALGEBRA_IMPL
+
+#endif  // ALEXANDRIA_NDARRAY_LINEARALGEBRA_H
@@ -28,6 +28,7 @@
 #include "AlexandriaKernel/memory_tools.h"
 #include <cassert>
 #include <iostream>
+#include <limits>
 #include <numeric>
 #include <stdexcept>
 #include <vector>
@@ -35,6 +36,18 @@
 namespace Euclid {
 namespace NdArray {
 
+/**
+ * Expected access pattern for the memory of an array. This is only a hint for the operating system,
+ * used by containers backed by memory mapped files (i.e. mmapNpy), and ignored by any other.
+ */
+enum class MemoryAdvice {
+  NORMAL,      ///< Default read-ahead
+  SEQUENTIAL,  ///< Aggressive read-ahead, and pages can be dropped soon after being accessed
+  RANDOM,      ///< No read-ahead
+  WILLNEED,    ///< Start reading the pages in the background
+  DONTNEED     ///< The pages are not needed anymore, and can be released
+};
+
 /**
  * Stores a multidimensional array in a contiguous piece of memory in row-major order
  * @tparam T
@@ -62,10 +75,20 @@ public:
   class Iterator : public std::iterator<std::random_access_iterator_tag, typename std::conditional<Const, const T, T>::type> {
   private:
     ContainerInterface* m_container_ptr;
-    size_t              m_offset;
+    /// Set only for arrays that are not contiguous, used to recompute the offset when jumping rows
+    const NdArray* m_array_ptr;
+    /// Logical position (in row-major order) and physical offset within the container
+    size_t m_i, m_offset;
+    /// Contiguous elements per row, the stride between them, and where the current row ends
+    size_t m_row_size, m_stride, m_row_end;
 
-    Iterator(ContainerInterface* container_ptr, size_t offset);
+    Iterator(ContainerInterface* container_ptr, const NdArray* array_ptr, size_t i);
 
+    /// Move to the logical position i
+    void seek(size_t i);
+
+    template <bool>
+    friend class Iterator;
     friend class NdArray;
 
   public:
@@ -216,6 +239,24 @@ public:
   template <template <class...> class Container = std::vector>
   NdArray(const std::vector<size_t>& shape_, Container<T>&& data);
 
+  /**
+   * Constructs a view over the given data with an explicit memory layout, similar to numpy's as_strided.
+   * @tparam Container
+   *    Owns the memory used by the NdArray. It must expose the methods size() and data().
+   * @param shape_
+   *    The shape of the matrix.
+   * @param strides
+   *    Distance, in number of elements, between two consecutive positions along each axis.
+   * @param offset
+   *    Position, within the container, of the first element.
+   * @param data
+   *    The data, which is moved into the NdArray.
+   * @throws std::invalid_argument
+   *    If the number of strides does not match the dimensionality, or the layout reaches past the end of the data.
+   */
+  template <template <class...> class Container = std::vector>
+  NdArray(const std::vector<size_t>& shape_, const std::vector<size_t>& strides, size_t offset, Container<T>&& data);
+
   /**
    * Constructs a matrix and initialize it with from the given iterators
    * @param shape_
@@ -314,6 +355,28 @@ public:
   template <typename... D>
   self_type& reshape(size_t i, D... rest);
 
+  /**
+   * Reorder the axes of the array.
+   * @param axes
+   *    New order of the axes: the axis i of the returned array corresponds to the axis axes[i] of this one.
+   * @return
+   *    A view that shares the data with this array, but has its shape and strides reordered. No data is
+   *    copied. See contiguousCopy if a dense copy is needed.
+   * @throws std::invalid_argument
+   *    If axes is not a permutation of the axes of the array
+   * @note
+   *    If the last axis is moved, the view loses the attribute names
+   */
+  self_type permuteAxes(const std::vector<size_t>& axes) const;
+
+  /**
+   * Reverse the order of the axes
+   * @return
+   *    A view that shares the data with this array. For a 2D array, the transposed matrix.
+   * @see permuteAxes
+   */
+  self_type transpose() const;
+
   /**
    * Gets a reference to the value stored at the given coordinates.
    * @param coords
@@ -405,10 +468,33 @@ public:
   const_iterator end() const;
 
   /**
-   * Size of the underlying container
+   * Number of elements of the array
    */
   size_t size() const;
 
+  /**
+   * Raw pointer to the first element of the array. This does not go through the container
+   * virtual interface, so it is the fast path for kernels operating directly on the memory.
+   * @note
+   *    Elements are laid out following strides(), which only correspond to a dense row-major
+   *    layout if isContiguous() is true
+   */
+  T* data();
+
+  /// @copydoc data()
+  const T* data() const;
+
+  /**
+   * Distance, in number of elements, between two consecutive positions of each axis
+   */
+  const std::vector<size_t>& strides() const;
+
+  /**
+   * @return
+   *    true if the elements are stored in row-major order without any gap between them
+   */
+  bool isContiguous() const;
+
   /**
    * Two NdArrays are equal if their shapes and their content are equal
    */
@@ -425,6 +511,49 @@ public:
    */
   self_type& concatenate(const self_type& other);
 
+  /**
+   * Concatenate to this array several others *along the first axis*. The container is resized only once,
+   * and the arrays are copied in parallel.
+   * @param others
+   *    Arrays to append, in order
+   * @param n_threads
+   *    Number of threads to use. 0 means one per available core. Small copies run on the calling thread.
+   * @return *this
+   * @throws std::length_error
+   *    If this array is a scalar, or the shapes, except for the first axis, do not match
+   * @throws std::invalid_argument
+   *    If this array is a view with a custom memory layout
+   */
+  self_type& concatenate(const std::vector<self_type>& others, unsigned int n_threads = 1);
+
+  /**
+   * Reserve storage for, at least, the given number of positions along the first axis, so the array can grow
+   * with concatenate up to that size without reallocating. This is only a hint: containers that can not
+   * reserve ignore it.
+   * @return *this
+   * @throws std::invalid_argument
+   *    If this array is a view with a custom memory layout
+   */
+  self_type& reserve(size_t rows);
+
+  /**
+   * Give a hint about how a range of positions along the first axis is going to be accessed.
+   * Containers backed by a memory mapped file forward it to the kernel (madvise), any other ignores it.
+   * @param advice
+   *    Expected access pattern
+   * @param begin_row
+   *    First position of the range
+   * @param end_row
+   *    Position after the last one of the range. By default, up to the end of the array.
+   */
+  void advise(MemoryAdvice advice, size_t begin_row = 0, size_t end_row = std::numeric_limits<size_t>::max()) const;
+
+  /**
+   * Start loading a range of positions along the first axis in the background, and return immediately, so they
+   * are already in memory when accessed. Same as advise(MemoryAdvice::WILLNEED, begin_row, end_row).
+   */
+  void prefetch(size_t begin_row, size_t end_row) const;
+
   /**
    * @return
    *    Attribute names
@@ -434,7 +563,7 @@ public:
 private:
   std::vector<size_t>      m_shape, m_stride_size;
   std::vector<std::string> m_attr_names;
-  size_t                   m_size;
+  size_t                   m_size, m_offset;
 
   struct ContainerInterface {
     /// Owned by the specific implementation ContainerWrapper,
@@ -456,9 +585,18 @@ private:
     /// @copydoc std::vector::size
     virtual size_t size() const = 0;
 
+    /// Number of elements reserved for a row (last axis) of the given length
+    virtual size_t paddedRowSize(size_t row_size) const = 0;
+
     /// Resize container
     virtual void resize(const std::vector<size_t>& shape) = 0;
 
+    /// Reserve storage for the given shape, so growing up to it does not reallocate
+    virtual void reserve(const std::vector<size_t>& shape) = 0;
+
+    /// Hint the expected access pattern for the elements in [begin, end)
+    virtual void advise(MemoryAdvice advice, size_t begin, size_t end) = 0;
+
     /// Expected to generate a deep copy of the underlying data
     virtual std::unique_ptr<ContainerInterface> copy() const = 0;
   };
@@ -483,6 +621,26 @@ private:
       return m_container.size();
     }
 
+    template <typename T2>
+    auto paddedRowSizeImpl(size_t row_size) const -> decltype(std::declval<const Container<T2>>().paddedRowSize(size_t{})) {
+      return m_container.paddedRowSize(row_size);
+    }
+
+    template <typename T2, typename... Ignored>
+    size_t paddedRowSizeImpl(size_t row_size, Ignored...) const {
+      return row_size;
+    }
+
+    /**
+     * @copybrief ContainerInterface::paddedRowSize
+     * @note
+     *  Containers that align each row (i.e. AlignedContainer) expose paddedRowSize(size_t). For
+     *  any other container the rows are stored back to back.
+     */
+    size_t paddedRowSize(size_t row_size) const final {
+      return paddedRowSizeImpl<T>(row_size);
+    }
+
     template <typename T2>
     auto resizeImpl(const std::vector<size_t>& shape)
         -> decltype((void)std::declval<Container<T2>>().resize(std::vector<size_t>{}), void()) {
@@ -507,9 +665,69 @@ private:
       m_data_ptr = m_container.data();
     }
 
-    std::unique_ptr<ContainerInterface> copy() const final {
+    template <typename T2>
+    auto reserveImpl(const std::vector<size_t>& shape)
+        -> decltype((void)std::declval<Container<T2>>().reserve(std::vector<size_t>{}), void()) {
+      m_container.reserve(shape);
+    }
+
+    template <typename T2>
+    auto reserveImpl(const std::vector<size_t>& shape) -> decltype((void)std::declval<Container<T2>>().reserve(size_t{}), void()) {
+      m_container.reserve(std::accumulate(shape.begin(), shape.end(), size_t{1}, std::multiplies<size_t>()));
+    }
+
+    template <typename T2, typename... Ignored>
+    void reserveImpl(const std::vector<size_t>&, Ignored...) {}
+
+    /**
+     * @copybrief ContainerInterface::reserve
+     * @note
+     *  As for resize, SFINAE selects between containers that reserve a number of elements (STL), those that
+     *  need the shape (i.e. Npy), and those that can not reserve at all, for which this is a no-op.
+     */
+    void reserve(const std::vector<size_t>& shape) final {
+      reserveImpl<T>(shape);
+      m_data_ptr = m_container.data();
+    }
+
+    template <typename T2>
+    auto adviseImpl(MemoryAdvice advice, size_t begin, size_t end)
+        -> decltype((void)std::declval<Container<T2>>().advise(advice, begin, end), void()) {
+      m_container.advise(advice, begin, end);
+    }
+
+    template <typename T2, typename... Ignored>
+    void adviseImpl(MemoryAdvice, size_t, size_t, Ignored...) {}
+
+    /**
+     * @copybrief ContainerInterface::advise
+     * @note
+     *  Only containers that expose advise(MemoryAdvice, size_t, size_t) (i.e. Npy memory mapped files) act on it
+     */
+    void advise(MemoryAdvice advice, size_t begin, size_t end) final {
+      adviseImpl<T>(advice, begin, end);
+    }
+
+    template <typename T2>
+    auto copyImpl() const -> decltype((void)std::declval<const Container<T2>>().copyToMemory(),
+                                      std::unique_ptr<ContainerInterface>()) {
+      return Euclid::make_unique<ContainerWrapper<std::vector>>(m_container.copyToMemory());
+    }
+
+    template <typename T2, typename... Ignored>
+    std::unique_ptr<ContainerInterface> copyImpl(Ignored...) const {
       return Euclid::make_unique<ContainerWrapper>(m_container);
     }
+
+    /**
+     * @copybrief ContainerInterface::copy
+     * @note
+     *  Containers whose copies share the storage (i.e. memory mapped files) expose copyToMemory(), which
+     *  returns a std::vector with a copy of their data.
+     */
+    std::unique_ptr<ContainerInterface> copy() const final {
+      return copyImpl<T>();
+    }
   };
 
   std::shared_ptr<ContainerInterface> m_container;
@@ -538,6 +756,25 @@ private:
    */
   void update_strides();
 
+  /**
+   * @return
+   *    true if the strides are those computed by update_strides, which is the layout the container
+   *    expects when resizing
+   */
+  bool has_natural_layout() const;
+
+  /**
+   * Verify that the container is big enough for the shape and strides
+   * @throws std::invalid_argument
+   *    If the data size does not corresponds to the matrix size.
+   */
+  void check_container_size() const;
+
+  /**
+   * Offset within the container of the element at the logical (row-major) position i
+   */
+  size_t physical_offset(size_t i) const;
+
   /**
    * Helper to expand at with a variable number of arguments
    */
@@ -571,6 +808,23 @@ private:
   self_type& reshape_helper(std::vector<size_t>& acc);
 };
 
+/**
+ * Concatenate several arrays along the first axis into a new one, allocating the result once and
+ * copying the blocks in parallel.
+ * @param arrays
+ *  Arrays to concatenate. The attribute names, if any, are taken from the first one.
+ * @param n_threads
+ *  Number of threads to use. 0 means one per available core.
+ * @return
+ *  A new array
+ * @throws std::invalid_argument
+ *  If the list is empty
+ * @throws std::length_error
+ *  If the shapes, except for the first axis, do not match
+ */
+template <typename T>
+NdArray<T> concatenate(const std::vector<NdArray<T>>& arrays, unsigned int n_threads = 1);
+
 /**
  * Serialize a NdArray
  */
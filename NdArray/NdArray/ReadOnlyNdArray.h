@@ -0,0 +1,123 @@
+/*
+ * Copyright (C) 2012-2020 Euclid Science Ground Segment
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+/**
+ * @file NdArray/ReadOnlyNdArray.h
+ * @date October 19, 2026
+ */
+
+#ifndef ALEXANDRIA_NDARRAY_READONLYNDARRAY_H
+#define ALEXANDRIA_NDARRAY_READONLYNDARRAY_H
+
+#include "NdArray/NdArray.h"
+
+namespace Euclid {
+namespace NdArray {
+
+/**
+ * @class ReadOnlyNdArray
+ * @brief
+ *  Read-only handle over an NdArray, i.e. one backed by a file mapped without write permission
+ * @details
+ *  The copies of an NdArray share its data, so a const NdArray does not prevent writes: it can be copied
+ *  into a non-const NdArray, and its views (transpose, permuteAxes) are not const. This class only exposes
+ *  the const interface of the array, its views are also ReadOnlyNdArray, and it can not be converted back
+ *  into an NdArray. Its copies share the data, as for NdArray. copy() gives a modifiable copy in memory.
+ * @tparam T
+ *  Cell type
+ */
+template <typename T>
+class ReadOnlyNdArray {
+public:
+  typedef typename NdArray<T>::const_iterator const_iterator;
+  typedef const_iterator                      iterator;
+
+  /**
+   * Constructor
+   * @param array
+   *    The array to wrap. It must not be modified through other copies of it.
+   */
+  explicit ReadOnlyNdArray(NdArray<T> array);
+
+  /// @copydoc NdArray::shape
+  const std::vector<size_t> shape() const;
+
+  /// @copydoc NdArray::size
+  size_t size() const;
+
+  /// @copydoc NdArray::strides
+  const std::vector<size_t>& strides() const;
+
+  /// @copydoc NdArray::isContiguous
+  bool isContiguous() const;
+
+  /// @copydoc NdArray::attributes
+  const std::vector<std::string>& attributes() const;
+
+  /// Gets a constant reference to the value stored at the given coordinates. See NdArray::at.
+  const T& at(const std::vector<size_t>& coords) const;
+
+  /// Gets a constant reference to the value stored at the given coordinates and attribute. See NdArray::at.
+  const T& at(const std::vector<size_t>& coords, const std::string& attr) const;
+
+  /// Gets a constant reference to the value stored at the given coordinates. See NdArray::at.
+  template <typename... D>
+  const T& at(size_t i, D... rest) const;
+
+  const_iterator begin() const;
+
+  const_iterator end() const;
+
+  /// @copydoc NdArray::data
+  const T* data() const;
+
+  /// Read-only view with the axes permuted. See NdArray::permuteAxes.
+  ReadOnlyNdArray permuteAxes(const std::vector<size_t>& axes) const;
+
+  /// Read-only view with the axes reversed. See NdArray::transpose.
+  ReadOnlyNdArray transpose() const;
+
+  /// Deep copy of the array in memory, which can be modified
+  NdArray<T> copy() const;
+
+  /// @copydoc NdArray::advise
+  void advise(MemoryAdvice advice, size_t begin_row = 0, size_t end_row = std::numeric_limits<size_t>::max()) const;
+
+  /// @copydoc NdArray::prefetch
+  void prefetch(size_t begin_row, size_t end_row) const;
+
+  bool operator==(const ReadOnlyNdArray& other) const;
+
+  bool operator!=(const ReadOnlyNdArray& other) const;
+
+  bool operator==(const NdArray<T>& other) const;
+
+  bool operator!=(const NdArray<T>& other) const;
+
+private:
+  NdArray<T> m_array;
+};
+
+}  // end of namespace NdArray
+}  // end of namespace Euclid
+
+#define READONLYNDARRAY_IMPL
+#include "NdArray/_impl/ReadOnlyNdArray.icpp"
+#undef READONLYNDARRAY_IMPL
+
+#endif  // ALEXANDRIA_NDARRAY_READONLYNDARRAY_H
@@ -0,0 +1,276 @@
+/*
+ * Copyright (C) 2012-2020 Euclid Science Ground Segment
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+/**
+ * @file NdArray/ReducedPrecision.h
+ * @date October 19, 2026
+ */
+
+#ifndef ALEXANDRIA_NDARRAY_REDUCEDPRECISION_H
+#define ALEXANDRIA_NDARRAY_REDUCEDPRECISION_H
+
+#include "NdArray/NdArray.h"
+#include <cstdint>
+#include <cstring>
+#include <limits>
+
+namespace Euclid {
+namespace NdArray {
+
+/**
+ * IEEE 754 half precision (binary16) floating point value: 11 significant bits (~3 decimal digits),
+ * and a range up to 65504. It is only meant for storage: arithmetic is done after an implicit conversion to float.
+ * It is stored in npy files as '<f2'.
+ */
+class Float16 {
+public:
+  Float16() = default;
+
+  /// Conversion from float, rounding to the nearest representable value
+  Float16(float value) : m_bits(fromFloat(value)) {}
+
+  /// Conversion to float, always exact
+  operator float() const {
+    return toFloat(m_bits);
+  }
+
+  /// Build from the binary representation
+  static Float16 fromBits(uint16_t bits) {
+    Float16 value;
+    value.m_bits = bits;
+    return value;
+  }
+
+  /// Binary representation
+  uint16_t bits() const {
+    return m_bits;
+  }
+
+  static uint16_t fromFloat(float value);
+
+  static float toFloat(uint16_t bits);
+
+private:
+  uint16_t m_bits;
+};
+
+/**
+ * bfloat16 floating point value: the upper half of a float, so it has the same range but only 8 significant bits.
+ * Conversions are cheaper than for Float16, but numpy has no equivalent dtype, so it can not be used with npy files.
+ */
+class BFloat16 {
+public:
+  BFloat16() = default;
+
+  /// Conversion from float, rounding to the nearest representable value
+  BFloat16(float value) : m_bits(fromFloat(value)) {}
+
+  /// Conversion to float, always exact
+  operator float() const {
+    return toFloat(m_bits);
+  }
+
+  /// Build from the binary representation
+  static BFloat16 fromBits(uint16_t bits) {
+    BFloat16 value;
+    value.m_bits = bits;
+    return value;
+  }
+
+  /// Binary representation
+  uint16_t bits() const {
+    return m_bits;
+  }
+
+  static uint16_t fromFloat(float value);
+
+  static float toFloat(uint16_t bits);
+
+private:
+  uint16_t m_bits;
+};
+
+/**
+ * Convert n values. This generic version casts one value at a time, and the overloads for Float16 and BFloat16
+ * convert several values at once (with the F16C instructions if the target supports them).
+ * Double values go through float, as there are no direct conversions.
+ */
+template <typename To, typename From>
+void convertValues(const From* src, To* dst, size_t n);
+
+void convertValues(const Float16* src, float* dst, size_t n);
+void convertValues(const float* src, Float16* dst, size_t n);
+void convertValues(const Float16* src, double* dst, size_t n);
+void convertValues(const double* src, Float16* dst, size_t n);
+void convertValues(const BFloat16* src, float* dst, size_t n);
+void convertValues(const float* src, BFloat16* dst, size_t n);
+void convertValues(const BFloat16* src, double* dst, size_t n);
+void convertValues(const double* src, BFloat16* dst, size_t n);
+
+/**
+ * Convert all the values of an array into a different type. This is intended to bulk-load a grid stored with reduced
+ * precision (or to shrink one before storing it), so the result is always a new contiguous array.
+ * @param src
+ *  Source array, with any layout
+ * @param n_threads
+ *  Number of threads to use. 0 means one per available core.
+ * @return
+ *  A new array with the same shape as src
+ */
+template <typename To, typename From>
+NdArray<To> convertArray(const NdArray<From>& src, unsigned int n_threads = 1);
+
+/**
+ * Store floating point values as scaled integers, so value = raw * scale + offset, following the same convention
+ * as the FITS BSCALE and BZERO keywords. Values are rounded to the nearest integer, and clipped to the range of I.
+ * NaN is stored as the lowest value of I, which is then reserved as a blank marker (as FITS BLANK).
+ * @tparam I
+ *  Integer storage type
+ * @param src
+ *  Values to store
+ * @param scale
+ *  Quantization step
+ * @param offset
+ *  Value corresponding to a raw value of 0
+ * @param n_threads
+ *  Number of threads to use. 0 means one per available core.
+ * @throws std::invalid_argument
+ *  If scale is 0 or not finite
+ */
+template <typename I, typename F>
+NdArray<I> quantize(const NdArray<F>& src, double scale, double offset, unsigned int n_threads = 1);
+
+/**
+ * Restore the floating point values stored by quantize
+ * @tparam F
+ *  Floating point type
+ * @param src
+ *  Raw values. The lowest value of I is converted into NaN.
+ * @param scale
+ *  Quantization step
+ * @param offset
+ *  Value corresponding to a raw value of 0
+ * @param n_threads
+ *  Number of threads to use. 0 means one per available core.
+ */
+template <typename F, typename I>
+NdArray<F> dequantize(const NdArray<I>& src, double scale, double offset, unsigned int n_threads = 1);
+
+/**
+ * Compute the scale and offset that map the interval [min, max] onto the full range of I (minus the blank marker),
+ * so the quantization error is at most (max - min) / (2 * (2^bits - 2))
+ * @return
+ *  A pair (scale, offset)
+ * @throws std::invalid_argument
+ *  If max is not greater than min
+ */
+template <typename I>
+std::pair<double, double> quantizationFor(double min, double max);
+
+}  // end of namespace NdArray
+}  // end of namespace Euclid
+
+namespace std {
+
+template <>
+class numeric_limits<Euclid::NdArray::Float16> {
+public:
+  static constexpr bool is_specialized = true;
+  static constexpr bool is_signed      = true;
+  static constexpr bool is_integer     = false;
+  static constexpr bool is_exact       = false;
+  static constexpr bool has_infinity   = true;
+  static constexpr bool has_quiet_NaN  = true;
+  static constexpr bool is_iec559      = true;
+  static constexpr int  digits         = 11;
+  static constexpr int  digits10       = 3;
+  static constexpr int  max_exponent   = 16;
+  static constexpr int  min_exponent   = -13;
+
+  static Euclid::NdArray::Float16 min() {
+    return Euclid::NdArray::Float16::fromBits(0x0400);
+  }
+
+  static Euclid::NdArray::Float16 max() {
+    return Euclid::NdArray::Float16::fromBits(0x7bff);
+  }
+
+  static Euclid::NdArray::Float16 lowest() {
+    return Euclid::NdArray::Float16::fromBits(0xfbff);
+  }
+
+  static Euclid::NdArray::Float16 epsilon() {
+    return Euclid::NdArray::Float16::fromBits(0x1400);
+  }
+
+  static Euclid::NdArray::Float16 infinity() {
+    return Euclid::NdArray::Float16::fromBits(0x7c00);
+  }
+
+  static Euclid::NdArray::Float16 quiet_NaN() {
+    return Euclid::NdArray::Float16::fromBits(0x7e00);
+  }
+};
+
+template <>
+class numeric_limits<Euclid::NdArray::BFloat16> {
+public:
+  static constexpr bool is_specialized = true;
+  static constexpr bool is_signed      = true;
+  static constexpr bool is_integer     = false;
+  static constexpr bool is_exact       = false;
+  static constexpr bool has_infinity   = true;
+  static constexpr bool has_quiet_NaN  = true;
+  static constexpr bool is_iec559      = false;
+  static constexpr int  digits         = 8;
+  static constexpr int  digits10       = 2;
+  static constexpr int  max_exponent   = 128;
+  static constexpr int  min_exponent   = -125;
+
+  static Euclid::NdArray::BFloat16 min() {
+    return Euclid::NdArray::BFloat16::fromBits(0x0080);
+  }
+
+  static Euclid::NdArray::BFloat16 max() {
+    return Euclid::NdArray::BFloat16::fromBits(0x7f7f);
+  }
+
+  static Euclid::NdArray::BFloat16 lowest() {
+    return Euclid::NdArray::BFloat16::fromBits(0xff7f);
+  }
+
+  static Euclid::NdArray::BFloat16 epsilon() {
+    return Euclid::NdArray::BFloat16::fromBits(0x3c00);
+  }
+
+  static Euclid::NdArray::BFloat16 infinity() {
+    return Euclid::NdArray::BFloat16::fromBits(0x7f80);
+  }
+
+  static Euclid::NdArray::BFloat16 quiet_NaN() {
+    return Euclid::NdArray::BFloat16::fromBits(0x7fc0);
+  }
+};
+
+}  // end of namespace std
+
+#define REDUCEDPRECISION_IMPL
+#include "NdArray/_impl/ReducedPrecision.icpp"
+#undef REDUCEDPRECISION_IMPL
+
+#endif  // ALEXANDRIA_NDARRAY_REDUCEDPRECISION_H
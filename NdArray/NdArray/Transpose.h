@@ -0,0 +1,82 @@
+/*
+ * Copyright (C) 2012-2020 Euclid Science Ground Segment
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#ifndef ALEXANDRIA_NDARRAY_TRANSPOSE_H
+#define ALEXANDRIA_NDARRAY_TRANSPOSE_H
+
+#include "NdArray/NdArray.h"
+
+namespace Euclid {
+namespace NdArray {
+
+/**
+ * Copy the content of an array, whatever its memory layout, into a new contiguous row-major array.
+ * The copy is done by tiles, so both the reads and the writes stay within cache even when the
+ * fastest varying axis of the source is not the last one (i.e. a transposed view).
+ * @tparam T
+ *  NdArray cell type
+ * @param array
+ *  Source array, typically a view returned by NdArray::permuteAxes or NdArray::transpose
+ * @param n_threads
+ *  Number of threads to use. 0 means one per available core
+ * @return
+ *  A new contiguous NdArray with the same shape and content
+ */
+template <typename T>
+NdArray<T> contiguousCopy(const NdArray<T>& array, unsigned int n_threads = 1);
+
+/**
+ * Reorder the axes of an array, copying the data into a new contiguous array.
+ * @param array
+ *  Source array
+ * @param axes
+ *  New order of the axes: the axis i of the returned array corresponds to the axis axes[i] of the source.
+ * @param n_threads
+ *  Number of threads to use. 0 means one per available core
+ * @return
+ *  A new contiguous NdArray
+ * @throws std::invalid_argument
+ *  If axes is not a permutation of the axes of the array
+ */
+template <typename T>
+NdArray<T> permuteAxesCopy(const NdArray<T>& array, const std::vector<size_t>& axes, unsigned int n_threads = 1) {
+  return contiguousCopy(array.permuteAxes(axes), n_threads);
+}
+
+/**
+ * Reverse the order of the axes of an array, copying the data into a new contiguous array.
+ * @param array
+ *  Source array
+ * @param n_threads
+ *  Number of threads to use. 0 means one per available core
+ * @return
+ *  A new contiguous NdArray
+ */
+template <typename T>
+NdArray<T> transposeCopy(const NdArray<T>& array, unsigned int n_threads = 1) {
+  return contiguousCopy(array.transpose(), n_threads);
+}
+
+}  // end of namespace NdArray
+}  // end of namespace Euclid
+
+#define TRANSPOSE_IMPL
+#include "NdArray/_impl/Transpose.icpp"
+#undef TRANSPOSE_IMPL
+
+#endif  // ALEXANDRIA_NDARRAY_TRANSPOSE_H
@@ -0,0 +1,234 @@
+/*
+ * Copyright (C) 2012-2020 Euclid Science Ground Segment
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#ifndef ALEXANDRIA_NDARRAY_IO_CHUNKEDARRAY_H
+#define ALEXANDRIA_NDARRAY_IO_CHUNKEDARRAY_H
+
+#include "NdArray/NdArray.h"
+#include <boost/filesystem/path.hpp>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+namespace Euclid {
+namespace NdArray {
+
+/**
+ * An out-of-core array stored as fixed-shape tiles (chunks), one file per tile, inside a directory.
+ * Only the tiles touched by an access are read, and a bounded number of them is kept in memory
+ * following a least-recently-used policy. Since every axis is split, reading a slice along any axis
+ * touches a number of tiles proportional to the slice, and not to the full array.
+ * @details
+ *  The layout follows the spirit of Zarr: the directory contains a file named `.chunks` with an npy header
+ *  describing the dtype, shape, tile shape and compression, and one file per tile named after its
+ *  coordinates on the tile grid (i.e. `0.3.1`). Tiles never written are not stored, and read as zeros.
+ *  Tiles on the border are stored with the full tile shape. Each tile can be compressed with zlib.
+ * @note
+ *  All accesses are serialized with a mutex, so an instance can be shared between threads.
+ * @tparam T
+ *  Cell type. Only the types supported by the npy format can be used.
+ * @code
+ * ChunkedArray<float> cube("/tmp/cube", {4000, 4000, 200}, {256, 256, 16}, 1);
+ * cube.write({0, 0, 0}, block);
+ * auto spectrum = cube.read({10, 20, 0}, {1, 1, 200});
+ * @endcode
+ */
+template <typename T>
+class ChunkedArray {
+public:
+  /**
+   * Open an existing chunked array
+   * @param path
+   *  Directory containing the array
+   * @param cache_size
+   *  Maximum number of tiles kept in memory
+   * @throws Elements::Exception
+   *  If the directory does not contain a chunked array, or the stored type does not match T
+   */
+  explicit ChunkedArray(const boost::filesystem::path& path, size_t cache_size = 64);
+
+  /**
+   * Create a new chunked array, initialized to zero
+   * @param path
+   *  Directory where to store the array. It will be created if it does not exist, and any tile already there
+   *  is removed.
+   * @param shape
+   *  Shape of the array
+   * @param chunk_shape
+   *  Shape of each tile
+   * @param compression_level
+   *  zlib compression level, from 0 (no compression) to 9
+   * @param cache_size
+   *  Maximum number of tiles kept in memory
+   * @throws std::invalid_argument
+   *  If the tile shape does not have the same number of axes as the shape, any of its axes is 0, or the
+   *  compression level is out of range
+   */
+  ChunkedArray(const boost::filesystem::path& path, const std::vector<size_t>& shape, const std::vector<size_t>& chunk_shape,
+               int compression_level = 0, size_t cache_size = 64);
+
+  ChunkedArray(const ChunkedArray&) = delete;
+  ChunkedArray& operator=(const ChunkedArray&) = delete;
+
+  /**
+   * Destructor. Writes back the modified tiles.
+   */
+  virtual ~ChunkedArray();
+
+  /// Shape of the array
+  const std::vector<size_t>& shape() const {
+    return m_shape;
+  }
+
+  /// Shape of each tile
+  const std::vector<size_t>& chunkShape() const {
+    return m_chunk_shape;
+  }
+
+  /// Number of tiles along each axis
+  const std::vector<size_t>& gridShape() const {
+    return m_grid_shape;
+  }
+
+  /// Number of elements of the array
+  size_t size() const;
+
+  /// zlib compression level of the tiles, 0 if they are not compressed
+  int compressionLevel() const {
+    return m_level;
+  }
+
+  /**
+   * Get a single element
+   * @throws std::out_of_range
+   *  If the coordinates are out of bounds
+   */
+  T get(const std::vector<size_t>& coords) const;
+
+  /**
+   * Set a single element
+   * @throws std::out_of_range
+   *  If the coordinates are out of bounds
+   */
+  void set(const std::vector<size_t>& coords, T value);
+
+  /**
+   * Read a region of the array
+   * @param offset
+   *  Coordinates of the first element of the region
+   * @param shape
+   *  Shape of the region
+   * @return
+   *  A new NdArray with the content of the region
+   * @throws std::out_of_range
+   *  If the region falls outside the array
+   */
+  NdArray<T> read(const std::vector<size_t>& offset, const std::vector<size_t>& shape) const;
+
+  /**
+   * Write a region of the array
+   * @param offset
+   *  Coordinates where the first element of data goes
+   * @param data
+   *  Content of the region. Its number of axes must match the one of the chunked array.
+   * @throws std::out_of_range
+   *  If the region falls outside the array
+   */
+  void write(const std::vector<size_t>& offset, const NdArray<T>& data);
+
+  /**
+   * Access directly a tile
+   * @param tile_coords
+   *  Coordinates of the tile on the tile grid
+   * @return
+   *  An NdArray backed by the cached tile, with the shape of the part of the tile that falls
+   *  inside the array. Modifications are written back to the storage.
+   *  The tile is pinned in memory, and never evicted, while the returned array (or any shallow copy of it) is alive.
+   * @throws std::out_of_range
+   *  If the tile coordinates are out of bounds
+   */
+  NdArray<T> tile(const std::vector<size_t>& tile_coords);
+
+  /**
+   * Write back all modified tiles
+   * @throws Elements::Exception
+   *  If a tile can not be written
+   */
+  void flush();
+
+  /// Number of tiles read from the storage since the array was opened
+  size_t tileLoads() const;
+
+  /// Number of tiles currently kept in memory
+  size_t cachedTiles() const;
+
+private:
+  struct Tile {
+    std::vector<T> data;
+    bool           dirty;
+  };
+  using LruList = std::list<size_t>;
+  using TileMap = std::unordered_map<size_t, std::pair<std::shared_ptr<Tile>, LruList::iterator>>;
+
+  boost::filesystem::path m_path;
+  std::vector<size_t>     m_shape, m_chunk_shape, m_grid_shape, m_chunk_strides;
+  size_t                  m_chunk_size;
+  int                     m_level;
+  size_t                  m_cache_size;
+
+  mutable std::mutex m_mutex;
+  mutable LruList    m_lru;
+  mutable TileMap    m_tiles;
+  mutable size_t     m_loads;
+
+  /// Compute the derived members from m_shape and m_chunk_shape
+  void init();
+
+  /// Path to the file backing the tile with the given linear index
+  boost::filesystem::path tilePath(size_t key) const;
+
+  /// Get a tile from the cache, loading it if needed, and evicting the least recently used ones
+  Tile& fetch(size_t key) const;
+
+  /// Read a tile from the storage
+  void load(size_t key, Tile& tile) const;
+
+  /// Write a tile to the storage
+  void store(size_t key, const Tile& tile) const;
+
+  /// Check that the region falls within the array
+  void checkRegion(const std::vector<size_t>& offset, const std::vector<size_t>& shape) const;
+
+  /**
+   * Call func(tile, tile_offset, region_offset, length) for every contiguous run of elements (along the last axis)
+   * of the region that falls within a single tile. The offsets are linear, in row-major order.
+   * Must be called with the mutex held.
+   */
+  template <typename Func>
+  void forEachRun(const std::vector<size_t>& offset, const std::vector<size_t>& shape, Func&& func) const;
+};
+
+}  // end of namespace NdArray
+}  // end of namespace Euclid
+
+#define CHUNKEDARRAY_IMPL
+#include "NdArray/io/_impl/ChunkedArray.icpp"
+#undef CHUNKEDARRAY_IMPL
+
+#endif  // ALEXANDRIA_NDARRAY_IO_CHUNKEDARRAY_H
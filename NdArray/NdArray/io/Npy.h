@@ -53,7 +53,8 @@ void writeNpy(std::ostream& out, const NdArray<T>& array);
  * @return
  *  A new NdArray
  * @note
- *  The underlying numpy format is expected to match the template type T
+ *  The stored data is converted to the native byte order. The stored type must either match the template
+ *  type T, or be safely convertible into it (i.e. float into double, or int16 into int32)
  */
 template <typename T>
 NdArray<T> readNpy(std::istream& input);
@@ -87,7 +88,8 @@ void writeNpy(const boost::filesystem::path& path, const NdArray<T>& array) {
  * @return
  *  A new NdArray
  * @note
- *  The underlying numpy format is expected to match the template type T
+ *  The stored data is converted to the native byte order. The stored type must either match the template
+ *  type T, or be safely convertible into it (i.e. float into double, or int16 into int32)
  */
 template <typename T>
 NdArray<T> readNpy(const boost::filesystem::path& path) {
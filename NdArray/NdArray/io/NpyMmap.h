@@ -20,8 +20,10 @@
 #define ALEXANDRIA_NDARRAY_IO_NPYMMAP_H
 
 #include "NdArray/NdArray.h"
+#include "NdArray/ReadOnlyNdArray.h"
 #include <boost/filesystem/path.hpp>
 #include <boost/iostreams/device/mapped_file.hpp>
+#include <memory>
 
 namespace Euclid {
 namespace NdArray {
@@ -35,9 +37,15 @@ namespace NdArray {
  * @param mode
  *  Open mode. By default read/write, so changes are persisted to disk.
  *  boost::iostreams::mapped_file_base::priv enabled a Copy-On-Write, so the memory can be modified
- *  but the changes will not persist
+ *  but the changes will not persist.
+ *  boost::iostreams::mapped_file_base::readonly maps the file without write permission, so any write
+ *  crashes the process. Prefer mmapNpyReadOnly, which catches them at compile time.
  * @param max_size
- *  Maximum size of the file. If you are going to call NdArray<T>::concatenate, mind this parameter!
+ *  Initial capacity of the mapping. In read/write mode, NdArray<T>::concatenate grows the mapping beyond it
+ *  when needed, and the file is truncated to its actual size once the array is released. Other modes can not grow.
+ * @param advice
+ *  Expected access pattern, forwarded to the kernel. It can be changed later for any range of rows with
+ *  NdArray<T>::advise, and NdArray<T>::prefetch starts loading a range of rows in the background.
  * @return
  *  A new NdArray
  * @note
@@ -48,7 +56,28 @@ namespace NdArray {
 template <typename T>
 NdArray<T> mmapNpy(const boost::filesystem::path&              path,
                    boost::iostreams::mapped_file_base::mapmode mode     = boost::iostreams::mapped_file_base::readwrite,
-                   size_t                                      max_size = 0);
+                   size_t                                      max_size = 0,
+                   MemoryAdvice                                advice   = MemoryAdvice::NORMAL);
+
+/**
+ * Open using mmap an existing numpy file, without write permission
+ * @details
+ *  The file is opened read-only, and mapped shared and read-only, so the pages are never copied nor dirtied:
+ *  any number of processes mapping the same file share the same physical memory, backed by the page cache.
+ *  The array is returned as a ReadOnlyNdArray, which only has the const interface, has read-only views, and can
+ *  not be converted into an NdArray, so any attempt to modify it, or to grow it, fails to compile.
+ *  ReadOnlyNdArray<T>::copy gives a modifiable copy in memory.
+ * @tparam T
+ *  NdArray cell type
+ * @param path
+ *  Input path
+ * @param advice
+ *  Expected access pattern, forwarded to the kernel
+ * @return
+ *  A new read-only array. Its copies share the mapping, which is released when the last one is destroyed.
+ */
+template <typename T>
+ReadOnlyNdArray<T> mmapNpyReadOnly(const boost::filesystem::path& path, MemoryAdvice advice = MemoryAdvice::NORMAL);
 
 /**
  * Create using mmap an NdArray backed by a numpy file
@@ -61,9 +90,12 @@ NdArray<T> mmapNpy(const boost::filesystem::path&              path,
  * @param attr_names
  *  Attribute names
  * @param max_size
- *  Maximum size of the file. If you are going to call NdArray<T>::concatenate, mind this parameter!
+ *  Initial capacity of the file. NdArray<T>::concatenate grows the file geometrically beyond it, so this
+ *  only avoids re-mapping. The file is truncated to its actual size once the array is released.
  * @return
  *  A new NdArray
+ * @note
+ *  The header is padded so the first axis can grow to any length
  */
 template <typename T>
 NdArray<T> createMmapNpy(const boost::filesystem::path& path, const std::vector<size_t>& shape,
@@ -78,9 +110,12 @@ NdArray<T> createMmapNpy(const boost::filesystem::path& path, const std::vector<
  * @param shape
  *  NdArray shape
  * @param max_size
- *  Maximum size of the file. If you are going to call NdArray<T>::concatenate, mind this parameter!
+ *  Initial capacity of the file. NdArray<T>::concatenate grows the file geometrically beyond it, so this
+ *  only avoids re-mapping. The file is truncated to its actual size once the array is released.
  * @return
  *  A new NdArray
+ * @note
+ *  The header is padded so the first axis can grow to any length
  */
 template <typename T>
 NdArray<T> createMmapNpy(const boost::filesystem::path& path, const std::vector<size_t>& shape, size_t max_size = 0) {
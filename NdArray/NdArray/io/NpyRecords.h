@@ -0,0 +1,229 @@
+/*
+ * Copyright (C) 2012-2020 Euclid Science Ground Segment
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#ifndef ALEXANDRIA_NDARRAY_IO_NPYRECORDS_H
+#define ALEXANDRIA_NDARRAY_IO_NPYRECORDS_H
+
+#include "NdArray/NdArray.h"
+#include "NdArray/ReadOnlyNdArray.h"
+#include <boost/filesystem/path.hpp>
+#include <boost/iostreams/device/mapped_file.hpp>
+#include <memory>
+
+namespace Euclid {
+namespace NdArray {
+
+/**
+ * Describes a field of a numpy structured dtype
+ */
+struct NpyField {
+  /// Field name
+  std::string name;
+  /// numpy type, without the byte order (i.e. "f4")
+  std::string dtype;
+  /// True if the values are stored as big-endian
+  bool big_endian;
+  /// Offset in bytes from the beginning of the record
+  size_t offset;
+  /// Shape of the sub-array, empty for scalar fields
+  std::vector<size_t> shape;
+
+  /// Size in bytes of a single value
+  size_t itemSize() const;
+
+  /// Number of values per record
+  size_t count() const;
+};
+
+/**
+ * Describe a field holding values of type T, stored with the native byte order
+ * @param name
+ *  Field name
+ * @param shape
+ *  Shape of the sub-array, empty for scalar fields
+ */
+template <typename T>
+NpyField npyField(const std::string& name, const std::vector<size_t>& shape = {});
+
+/**
+ * An array of records with heterogeneous fields, as described by a numpy structured dtype
+ * (i.e. [('id', '<i8'), ('flux', '<f4', (9,))]).
+ * Each field can be accessed as an NdArray. When the field type matches, and its values are suitably aligned,
+ * the NdArray is a strided view over the records, so no data is copied and modifications are visible on the records.
+ * Through a const NpyRecordArray, or when the records are read-only, the fields are given as ReadOnlyNdArray.
+ * @code
+ * auto catalog = mmapNpyRecords("/tmp/catalog.npy");
+ * auto ids     = catalog.field<int64_t>("id");    // shape (n,)
+ * auto fluxes  = catalog.field<float>("flux");    // shape (n, 9)
+ * @endcode
+ */
+class NpyRecordArray {
+public:
+  /**
+   * Constructor. Allocates zero-initialized records
+   * @param shape
+   *  Shape of the array of records
+   * @param fields
+   *  Fields of each record. Their offsets are ignored, as they are packed in the given order, as numpy does
+   *  by default
+   */
+  NpyRecordArray(const std::vector<size_t>& shape, std::vector<NpyField> fields);
+
+  /**
+   * Constructor. Wraps records owned elsewhere
+   * @param owner
+   *  Kept alive for as long as this array, or any view over its fields, exists
+   * @param data
+   *  Address of the first record
+   * @param shape
+   *  Shape of the array of records
+   * @param fields
+   *  Fields of each record
+   * @param record_size
+   *  Size in bytes of each record, including any padding
+   * @param readonly
+   *  If true, the records must not be modified, i.e. they are mapped without write permission
+   */
+  NpyRecordArray(std::shared_ptr<void> owner, char* data, const std::vector<size_t>& shape, std::vector<NpyField> fields,
+                 size_t record_size, bool readonly = false);
+
+  /// Shape of the array of records
+  const std::vector<size_t>& shape() const;
+
+  /// Number of records
+  size_t size() const;
+
+  /// Size in bytes of a record
+  size_t recordSize() const;
+
+  /// Fields of each record
+  const std::vector<NpyField>& fields() const;
+
+  /// True if the records can not be modified
+  bool isReadOnly() const;
+
+  /**
+   * Description of the field with the given name
+   * @throws Elements::Exception
+   *  If there is no such field
+   */
+  const NpyField& fieldInfo(const std::string& name) const;
+
+  /**
+   * Access a field
+   * @tparam T
+   *  NdArray cell type
+   * @param name
+   *  Field name
+   * @return
+   *  An NdArray with the shape of the records, followed by the shape of the field. If the stored type is T, with the
+   *  native byte order, and aligned, it is a view over the records. Otherwise, it is a copy converted into T.
+   * @throws Elements::Exception
+   *  If the records are read-only, the field does not exist, or its type can not be safely converted into T
+   */
+  template <typename T>
+  NdArray<T> field(const std::string& name);
+
+  /**
+   * Access a field without modifying it
+   * @return
+   *  As for the non-const overload, but read-only. This is the only access to read-only records.
+   * @throws Elements::Exception
+   *  If the field does not exist, or its type can not be safely converted into T
+   */
+  template <typename T>
+  ReadOnlyNdArray<T> field(const std::string& name) const;
+
+  /**
+   * Address of the first record
+   * @throws Elements::Exception
+   *  If the records are read-only
+   */
+  char* data();
+
+  /// @copydoc data()
+  const char* data() const;
+
+private:
+  std::shared_ptr<void> m_owner;
+  char*                 m_data;
+  std::vector<size_t>   m_shape;
+  std::vector<NpyField> m_fields;
+  size_t                m_record_size;
+  bool                  m_readonly;
+
+  /// View or converted copy of a field, shared by both overloads of field()
+  template <typename T>
+  NdArray<T> fieldArray(const std::string& name) const;
+};
+
+/**
+ * Read a numpy structured array
+ * @param input
+ *  Input stream
+ * @throws Elements::Exception
+ *  If the stored dtype is not structured, or uses nested structures
+ */
+NpyRecordArray readNpyRecords(std::istream& input);
+
+/**
+ * @copydoc readNpyRecords(std::istream&)
+ */
+NpyRecordArray readNpyRecords(const boost::filesystem::path& path);
+
+/**
+ * Open using mmap a numpy file with a structured array
+ * @param path
+ *  Input path
+ * @param mode
+ *  Open mode. By default read/write, so changes done through the field views are persisted to disk.
+ *  With read-only, the records can only be accessed through a const NpyRecordArray.
+ */
+NpyRecordArray mmapNpyRecords(const boost::filesystem::path&              path,
+                              boost::iostreams::mapped_file_base::mapmode mode = boost::iostreams::mapped_file_base::readwrite);
+
+/**
+ * Create using mmap a numpy file with a structured array
+ * @param path
+ *  Output path
+ * @param shape
+ *  Shape of the array of records
+ * @param fields
+ *  Fields of each record. As for the NpyRecordArray constructor, they are packed in the given order
+ */
+NpyRecordArray createMmapNpyRecords(const boost::filesystem::path& path, const std::vector<size_t>& shape,
+                                    std::vector<NpyField> fields);
+
+/**
+ * Write a structured array following numpy format
+ */
+void writeNpyRecords(std::ostream& out, const NpyRecordArray& records);
+
+/**
+ * @copydoc writeNpyRecords(std::ostream&, const NpyRecordArray&)
+ */
+void writeNpyRecords(const boost::filesystem::path& path, const NpyRecordArray& records);
+
+}  // end of namespace NdArray
+}  // end of namespace Euclid
+
+#define NPYRECORDS_IMPL
+#include "NdArray/io/_impl/NpyRecords.icpp"
+#undef NPYRECORDS_IMPL
+
+#endif  // ALEXANDRIA_NDARRAY_IO_NPYRECORDS_H
@@ -0,0 +1,139 @@
+/*
+ * Copyright (C) 2012-2020 Euclid Science Ground Segment
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#ifndef ALEXANDRIA_NDARRAY_IO_NPYSTREAMWRITER_H
+#define ALEXANDRIA_NDARRAY_IO_NPYSTREAMWRITER_H
+
+#include "NdArray/NdArray.h"
+#include <boost/filesystem/path.hpp>
+#include <fstream>
+#include <memory>
+
+namespace Euclid {
+namespace NdArray {
+
+/**
+ * Write a numpy file incrementally, a chunk of rows at a time, so the full array does not need to fit in memory.
+ * The header is written first with room enough for any number of rows, and rewritten with the
+ * final shape when the writer is closed.
+ * @tparam T
+ *  NdArray cell type
+ * @code
+ * NpyStreamWriter<double> writer("/tmp/output.npy", {n_bands});
+ * for (auto& chunk : chunks) {
+ *   writer.append(chunk); // shape (n, n_bands)
+ * }
+ * writer.close();
+ * @endcode
+ */
+template <typename T>
+class NpyStreamWriter {
+public:
+  /**
+   * Constructor
+   * @param path
+   *  Output path. It will be truncated if it exists.
+   * @param row_shape
+   *  Shape of each row, this is, the shape of the final array without the first axis
+   * @param attr_names
+   *  Attribute names. As for the NdArray constructor, they add an extra axis after row_shape.
+   */
+  NpyStreamWriter(const boost::filesystem::path& path, const std::vector<size_t>& row_shape,
+                  const std::vector<std::string>& attr_names = {});
+
+  /**
+   * Constructor
+   * @param out
+   *  Output stream. It must be seekable, as the header is re-written when closing. The array is written
+   *  starting at the current position.
+   * @param row_shape
+   *  Shape of each row, this is, the shape of the final array without the first axis
+   * @param attr_names
+   *  Attribute names. As for the NdArray constructor, they add an extra axis after row_shape.
+   */
+  NpyStreamWriter(std::ostream& out, const std::vector<size_t>& row_shape, const std::vector<std::string>& attr_names = {});
+
+  NpyStreamWriter(const NpyStreamWriter&) = delete;
+  NpyStreamWriter& operator=(const NpyStreamWriter&) = delete;
+
+  /**
+   * Destructor. Closes the writer if close has not been called
+   */
+  virtual ~NpyStreamWriter();
+
+  /**
+   * Append a chunk of rows
+   * @param chunk
+   *  Its shape must be (n, row_shape...)
+   * @throws std::length_error
+   *  If the shape of the chunk does not match
+   * @throws Elements::Exception
+   *  If the writer has been closed, or the write fails
+   */
+  void append(const NdArray<T>& chunk);
+
+  /**
+   * Append a chunk of rows from a contiguous buffer
+   * @param data
+   *  Pointer to the first element. The buffer must hold n_rows * row_size() elements
+   * @param n_rows
+   *  Number of rows
+   */
+  void append(const T* data, size_t n_rows);
+
+  /**
+   * Number of elements of each row
+   */
+  size_t rowSize() const;
+
+  /**
+   * Number of rows written so far
+   */
+  size_t rows() const;
+
+  /**
+   * Rewrite the header with the final shape, and flush the output
+   * @throws Elements::Exception
+   *  If the write fails
+   */
+  void close();
+
+private:
+  std::unique_ptr<std::ofstream> m_owned_stream;
+  std::ostream*                  m_out;
+  std::streampos                 m_header_start;
+  std::vector<size_t>            m_row_shape;
+  std::vector<std::string>       m_attr_names;
+  size_t                         m_row_size, m_rows, m_header_size;
+  bool                           m_closed;
+
+  /// Common initialization, writes the placeholder header
+  void init(const std::vector<size_t>& row_shape, const std::vector<std::string>& attr_names);
+
+  /// Shape with the given number of rows
+  std::vector<size_t> shapeFor(size_t rows) const;
+};
+
+}  // end of namespace NdArray
+}  // end of namespace Euclid
+
+#define NPYSTREAMWRITER_IMPL
+#include "NdArray/io/_impl/NpyStreamWriter.icpp"
+#undef NPYSTREAMWRITER_IMPL
+
+#endif  // ALEXANDRIA_NDARRAY_IO_NPYSTREAMWRITER_H
@@ -0,0 +1,179 @@
+/*
+ * Copyright (C) 2012-2020 Euclid Science Ground Segment
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#ifndef ALEXANDRIA_NDARRAY_IO_NPZ_H
+#define ALEXANDRIA_NDARRAY_IO_NPZ_H
+
+#include "NdArray/NdArray.h"
+#include <boost/filesystem/path.hpp>
+#include <boost/iostreams/device/mapped_file.hpp>
+#include <fstream>
+#include <map>
+#include <memory>
+
+namespace Euclid {
+namespace NdArray {
+
+/**
+ * Read arrays from a numpy .npz archive, as written by numpy.savez and numpy.savez_compressed.
+ * The archive is memory mapped (copy on write). Members stored without compression are returned as
+ * views over the mapping, so no data is read until it is accessed. Deflated members are decompressed directly
+ * into the returned array.
+ * @see
+ *  https://numpy.org/devdocs/reference/generated/numpy.lib.format.html
+ * @code
+ * NpzReader npz("/tmp/model.npz");
+ * auto fluxes = npz.read<double>("fluxes");
+ * @endcode
+ */
+class NpzReader {
+public:
+  /**
+   * Constructor
+   * @param path
+   *  Path to the .npz file
+   * @throws Elements::Exception
+   *  If the file is not a valid zip archive
+   */
+  explicit NpzReader(const boost::filesystem::path& path);
+
+  /**
+   * Names of the arrays contained in the archive, without the .npy suffix
+   */
+  std::vector<std::string> keys() const;
+
+  /**
+   * @return true if the archive contains an array with the given name
+   */
+  bool contains(const std::string& key) const;
+
+  /**
+   * @return true if the array with the given name is compressed
+   */
+  bool isCompressed(const std::string& key) const;
+
+  /**
+   * Read an array
+   * @tparam T
+   *  NdArray cell type. The stored array is converted as readNpy does if its type differs.
+   * @param key
+   *  Name of the array, without the .npy suffix
+   * @return
+   *  A new NdArray. If the member is not compressed, has type T, and the data is suitably aligned, the NdArray
+   *  is backed by the memory mapped file. Modifications are private to this reader: they are visible to other
+   *  arrays read from it, but the file is never modified.
+   * @throws Elements::Exception
+   *  If the key does not exist, the stored type can not be safely converted into T, or the member uses an
+   *  unsupported compression method
+   */
+  template <typename T>
+  NdArray<T> read(const std::string& key) const;
+
+private:
+  struct Member {
+    uint16_t method;
+    uint64_t compressed_size, uncompressed_size, data_offset;
+  };
+
+  boost::filesystem::path                        m_path;
+  std::shared_ptr<boost::iostreams::mapped_file> m_mapped;
+  std::map<std::string, Member>                  m_members;
+
+  /// Look up a member
+  const Member& member(const std::string& key) const;
+};
+
+/**
+ * Write arrays into a numpy .npz archive, readable by numpy.load.
+ * Uncompressed members are padded so the array data is aligned to 64 bytes, which allows NpzReader
+ * to return them without any copy.
+ * @code
+ * NpzWriter npz("/tmp/model.npz", 6);
+ * npz.write("fluxes", fluxes);
+ * npz.write("wavelength", wavelength);
+ * npz.close();
+ * @endcode
+ */
+class NpzWriter {
+public:
+  /**
+   * Constructor
+   * @param path
+   *  Output path. It will be truncated if it exists.
+   * @param compression_level
+   *  0 stores the arrays without compression (as numpy.savez). 1 to 9 use deflate (as numpy.savez_compressed), trading
+   *  speed for size.
+   * @throws std::invalid_argument
+   *  If the compression level is out of range
+   */
+  explicit NpzWriter(const boost::filesystem::path& path, int compression_level = 0);
+
+  NpzWriter(const NpzWriter&) = delete;
+  NpzWriter& operator=(const NpzWriter&) = delete;
+
+  /**
+   * Destructor. Closes the archive if close has not been called
+   */
+  virtual ~NpzWriter();
+
+  /**
+   * Add an array to the archive
+   * @param key
+   *  Name of the array. The member is stored as key.npy
+   * @param array
+   *  Array to write
+   * @throws std::invalid_argument
+   *  If the key has already been written
+   * @throws Elements::Exception
+   *  If the archive has been closed, or the write fails
+   */
+  template <typename T>
+  void write(const std::string& key, const NdArray<T>& array);
+
+  /**
+   * Write the central directory and close the file
+   */
+  void close();
+
+private:
+  struct Entry {
+    std::string name;
+    uint16_t    method;
+    uint32_t    crc;
+    uint64_t    compressed_size, uncompressed_size, header_offset;
+  };
+
+  std::ofstream      m_out;
+  int                m_level;
+  uint16_t           m_dos_time, m_dos_date;
+  std::vector<Entry> m_entries;
+  bool               m_closed;
+
+  /// Write a member given its npy header and the raw data
+  void writeMember(const std::string& key, const std::string& npy_header, const char* data, size_t size);
+};
+
+}  // end of namespace NdArray
+}  // end of namespace Euclid
+
+#define NPZ_IMPL
+#include "NdArray/io/_impl/NpzReader.icpp"
+#include "NdArray/io/_impl/NpzWriter.icpp"
+#undef NPZ_IMPL
+
+#endif  // ALEXANDRIA_NDARRAY_IO_NPZ_H
@@ -20,10 +20,18 @@
 #define ALEXANDRIA_NDARRAY_IMPL_NPYCOMMON_H
 
 #include "AlexandriaKernel/StringUtils.h"
+#include "NdArray/ReducedPrecision.h"
+#include <algorithm>
 #include <boost/endian/arithmetic.hpp>
 #include <boost/filesystem/operations.hpp>
 #include <boost/iostreams/device/mapped_file.hpp>
 #include <boost/regex.hpp>
+#include <cerrno>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <sys/mman.h>
+#include <unistd.h>
 
 namespace Euclid {
 namespace NdArray {
@@ -103,6 +111,30 @@ struct NpyDtype<double> {
   static constexpr const char* str = "f8";
 };
 
+template <>
+struct NpyDtype<Float16> {
+  static constexpr const char* str = "f2";
+};
+
+/**
+ * @return true if the dtype read from a npy file corresponds to the type T
+ */
+template <typename T>
+bool isNpyDtype(const std::string& dtype) {
+  return dtype == NpyDtype<T>::str;
+}
+
+/// numpy writes single byte integers as i1 and u1
+template <>
+inline bool isNpyDtype<int8_t>(const std::string& dtype) {
+  return dtype == NpyDtype<int8_t>::str || dtype == "i1";
+}
+
+template <>
+inline bool isNpyDtype<uint8_t>(const std::string& dtype) {
+  return dtype == NpyDtype<uint8_t>::str || dtype == "u1";
+}
+
 /**
  * Parse a single dtype description (i.e. '<f8')
  */
@@ -143,6 +175,31 @@ inline void parseFieldValues(const std::string& descr, bool& big_endian, std::ve
   }
 }
 
+/**
+ * Parse a tuple of integers stored under the given key on the dictionary serialized on the npy file
+ * @throws Elements::Exception
+ *  If the key is not present
+ */
+inline std::vector<size_t> parseNpyTuple(const std::string& header, const std::string& key) {
+  auto loc = header.find("'" + key + "'");
+  if (loc == std::string::npos) {
+    throw Elements::Exception() << "Missing key " << key << " on the npy header";
+  }
+  loc            = header.find('(', loc) + 1;
+  auto loc2      = header.find(')', loc);
+  auto shape_str = header.substr(loc, loc2 - loc);
+  if (!shape_str.empty() && shape_str.back() == ',')
+    shape_str.resize(shape_str.size() - 1);
+  return stringToVector<size_t>(shape_str);
+}
+
+/**
+ * Parse the shape from the dictionary serialized on the npy file
+ */
+inline std::vector<size_t> parseNpyShape(const std::string& header) {
+  return parseNpyTuple(header, "shape");
+}
+
 /**
  * Parse the dictionary serialized on the npy file
  * @param header
@@ -177,31 +234,18 @@ inline void parseNpyDict(const std::string& header, bool& fortran_order, bool& b
     throw Elements::Exception() << "Failed to parse the array description: " << header;
   }
 
-  loc            = header.find("shape") + 9;
-  auto loc2      = header.find(')', loc);
-  auto shape_str = header.substr(loc, loc2 - loc);
-  if (shape_str.back() == ',')
-    shape_str.resize(shape_str.size() - 1);
-  shape      = stringToVector<size_t>(shape_str);
+  shape      = parseNpyShape(header);
   n_elements = std::accumulate(shape.begin(), shape.end(), 1, std::multiplies<size_t>());
 }
 
 /**
- * Read the npy header
+ * Read the magic, version and the serialized header dictionary
  * @param input
  *  Input stream
- * @param dtype [out]
- *  Put here the read dtype
- * @param shape [out]
- *  Put here the read shape
- * @param attrs [out]
- *  Put here the attribute names
- * @param n_elements [out]
- *  Total number of elements (multiplication of shape)
  * @return
+ *  The string representation of the dictionary
  */
-inline void readNpyHeader(std::istream& input, std::string& dtype, std::vector<size_t>& shape, std::vector<std::string>& attrs,
-                          size_t& n_elements) {
+inline std::string readNpyHeaderDict(std::istream& input) {
   // Magic
   char magic[6];
   input.read(magic, sizeof(magic));
@@ -228,18 +272,65 @@ inline void readNpyHeader(std::istream& input, std::string& dtype, std::vector<s
   // Read header
   std::string header(header_len, '\0');
   input.read(&header[0], header_len);
+  return header;
+}
+
+/**
+ * Read the npy header
+ * @param input
+ *  Input stream
+ * @param dtype [out]
+ *  Put here the read dtype
+ * @param shape [out]
+ *  Put here the read shape
+ * @param attrs [out]
+ *  Put here the attribute names
+ * @param n_elements [out]
+ *  Total number of elements (multiplication of shape)
+ * @param fortran_order [out]
+ *  Put here if the data is stored in column-major order
+ * @param big_endian [out]
+ *  Put here if the data is stored in big-endian order
+ */
+inline void readNpyHeader(std::istream& input, std::string& dtype, std::vector<size_t>& shape, std::vector<std::string>& attrs,
+                          size_t& n_elements, bool& fortran_order, bool& big_endian) {
+  auto header = readNpyHeaderDict(input);
 
   // Parse header
-  bool fortran_order, big_endian;
   parseNpyDict(header, fortran_order, big_endian, dtype, shape, attrs, n_elements);
 
-  if (fortran_order)
-    throw Elements::Exception() << "Fortran order not supported";
+  if (fortran_order && !attrs.empty())
+    throw Elements::Exception() << "Fortran order not supported for arrays with named fields";
+}
 
+/**
+ * Read the npy header, only accepting data stored with the native endianness
+ * @throws Elements::Exception
+ *  If the endianness of the data does not match the native one
+ * @see readNpyHeader(std::istream&, std::string&, std::vector<size_t>&, std::vector<std::string>&, size_t&, bool&, bool&)
+ */
+inline void readNpyHeader(std::istream& input, std::string& dtype, std::vector<size_t>& shape, std::vector<std::string>& attrs,
+                          size_t& n_elements, bool& fortran_order) {
+  bool big_endian;
+  readNpyHeader(input, dtype, shape, attrs, n_elements, fortran_order, big_endian);
   if (big_endian && (BYTE_ORDER != BIG_ENDIAN))
     throw Elements::Exception() << "Only native endianness supported for reading";
 }
 
+/**
+ * Read the npy header, only accepting data stored in row-major order
+ * @throws Elements::Exception
+ *  If the data is stored in column-major (Fortran) order
+ * @see readNpyHeader(std::istream&, std::string&, std::vector<size_t>&, std::vector<std::string>&, size_t&, bool&)
+ */
+inline void readNpyHeader(std::istream& input, std::string& dtype, std::vector<size_t>& shape, std::vector<std::string>& attrs,
+                          size_t& n_elements) {
+  bool fortran_order;
+  readNpyHeader(input, dtype, shape, attrs, n_elements, fortran_order);
+  if (fortran_order)
+    throw Elements::Exception() << "Fortran order not supported";
+}
+
 /**
  * We write arrays following 2.0 version (32 bits header size)
  */
@@ -275,32 +366,49 @@ inline std::string typeDescription(const std::string& type, const std::vector<st
 }
 
 /**
- * Write header
+ * Serialize the header dictionary as a Python dict
+ * @param shape
+ *  Array shape. If there are attributes, the last axis corresponds to them
+ * @param attrs
+ *  Attribute names
+ * @throws std::out_of_range
+ *  If the last axis does not match the number of attributes
  */
 template <typename T>
-void writeNpyHeader(std::ostream& out, std::vector<size_t> shape, const std::vector<std::string>& attrs) {
+std::string npyHeaderDict(std::vector<size_t> shape, const std::vector<std::string>& attrs) {
   if (!attrs.empty()) {
     if (attrs.size() != shape.back()) {
       throw std::out_of_range("Last axis does not match number of attribute names");
     }
     shape.pop_back();
   }
-  // Serialize header as a Python dict
   std::stringstream header;
   header << "{"
          << "'descr': " << typeDescription(NpyDtype<T>::str, attrs) << ", 'fortran_order': False, 'shape': " << npyShape(shape)
          << "}";
-  auto            header_str = header.str();
-  little_uint32_t header_len = header_str.size();
-
-  // Pad header with spaces so the header block is 64 bytes aligned
-  size_t total_length = sizeof(NPY_MAGIC) + sizeof(NPY_VERSION) + sizeof(header_len) + header_len - 1;  // Keep 1 for \n
-  size_t padding      = 64 - total_length % 64;
-  if (padding) {
-    header << std::string(padding, '\x20') << '\n';
-    header_str = header.str();
-    header_len = header_str.size();
-  }
+  return header.str();
+}
+
+/**
+ * Write the magic, version and header dictionary. The dictionary is padded with spaces so the data that follows
+ * starts at a multiple of 64 bytes.
+ * @param out
+ *  Output stream
+ * @param dict
+ *  Serialized dictionary
+ * @param min_length
+ *  Pad further so the written block is, at least, this long. This allows to reserve space for a header
+ *  that will be rewritten later with a longer shape.
+ * @return
+ *  The number of bytes written
+ */
+inline size_t writeNpyHeaderBlock(std::ostream& out, std::string dict, size_t min_length = 0) {
+  // Magic, version, header length, dictionary and the trailing \n
+  size_t total_length = sizeof(NPY_MAGIC) + sizeof(NPY_VERSION) + sizeof(little_uint32_t) + dict.size() + 1;
+  size_t padded       = std::max(min_length, ((total_length + 63) / 64) * 64);
+  dict.append(padded - total_length, '\x20');
+  dict.push_back('\n');
+  little_uint32_t header_len = dict.size();
 
   // Magic and version
   out.write(NPY_MAGIC, sizeof(NPY_MAGIC));
@@ -310,12 +418,86 @@ void writeNpyHeader(std::ostream& out, std::vector<size_t> shape, const std::vec
   out.write(reinterpret_cast<char*>(&header_len), sizeof(header_len));
 
   // HEADER
-  out.write(header_str.data(), header_str.size());
+  out.write(dict.data(), dict.size());
+  return padded;
+}
+
+/**
+ * Write header
+ */
+template <typename T>
+void writeNpyHeader(std::ostream& out, std::vector<size_t> shape, const std::vector<std::string>& attrs) {
+  writeNpyHeaderBlock(out, npyHeaderDict<T>(std::move(shape), attrs));
+}
+
+/**
+ * Container over memory owned by someone else (i.e. a memory mapped file, or a buffer with records), which is
+ * kept alive for as long as any array uses it. Copying or resizing moves the data into owned memory.
+ * @tparam T
+ *  Contained value type
+ */
+template <typename T>
+class SharedBufferContainer {
+public:
+  SharedBufferContainer(std::shared_ptr<void> owner, T* data, size_t n_elements)
+      : m_owner(std::move(owner)), m_data(data), m_size(n_elements) {}
+
+  SharedBufferContainer(const SharedBufferContainer& other)
+      : m_owned(other.m_data, other.m_data + other.m_size), m_size(other.m_size) {
+    m_data = m_owned.data();
+  }
+
+  SharedBufferContainer(SharedBufferContainer&&) = default;
+
+  size_t size() const {
+    return m_size;
+  }
+
+  T* data() {
+    return m_data;
+  }
+
+  void resize(const std::vector<size_t>& shape) {
+    if (m_owner) {
+      m_owned.assign(m_data, m_data + m_size);
+      m_owner.reset();
+    }
+    m_size = std::accumulate(shape.begin(), shape.end(), size_t{1}, std::multiplies<size_t>());
+    m_owned.resize(m_size);
+    m_data = m_owned.data();
+  }
+
+private:
+  std::shared_ptr<void> m_owner;
+  std::vector<T>        m_owned;
+  T*                    m_data;
+  size_t                m_size;
+};
+
+/**
+ * Header for a new npy file, padded so the first axis can grow to any size without changing its length
+ */
+template <typename T>
+std::string npyGrowableHeader(const std::vector<size_t>& shape, const std::vector<std::string>& attrs) {
+  size_t reserved = 0;
+  if (!shape.empty()) {
+    std::vector<size_t> widest(shape);
+    widest.front() = std::numeric_limits<size_t>::max();
+    std::stringstream placeholder;
+    reserved = writeNpyHeaderBlock(placeholder, npyHeaderDict<T>(widest, attrs));
+  }
+  std::stringstream header;
+  writeNpyHeaderBlock(header, npyHeaderDict<T>(shape, attrs), reserved);
+  return header.str();
 }
 
 /**
  * A memory mapped container that can be used by NdArray.
  * Builds on top of boost::iostream::mapped_file
+ * @details
+ *  When mapped read/write, the container grows as needed: if a resize exceeds the mapped capacity, the file
+ *  is extended and re-mapped with, at least, twice the capacity. The file is truncated to the actual size of the
+ *  array once the last copy of the container is released.
  * @tparam T
  *  Contained value type
  */
@@ -324,13 +506,11 @@ class MappedContainer {
 public:
   MappedContainer(const boost::filesystem::path& path, size_t data_offset, size_t n_elements,
                   const std::vector<std::string>& attr_names, boost::iostreams::mapped_file&& input, size_t max_size)
-      : m_path(path)
-      , m_data_offset(data_offset)
+      : m_data_offset(data_offset)
       , m_n_elements(n_elements)
-      , m_max_size(max_size)
       , m_attr_names(attr_names)
-      , m_mapped(std::move(input))
-      , m_data(reinterpret_cast<T*>(m_mapped.data() + data_offset)) {}
+      , m_file(std::make_shared<File>(path, std::move(input), max_size, data_offset + n_elements * sizeof(T)))
+      , m_data(reinterpret_cast<T*>(const_cast<char*>(m_file->mapped.const_data()) + data_offset)) {}
 
   size_t size() const {
     return m_n_elements;
@@ -341,32 +521,136 @@ public:
   }
 
   void resize(const std::vector<size_t>& shape) {
-    // Generate header
+    if (m_file->mapped.flags() == boost::iostreams::mapped_file_base::readonly) {
+      throw Elements::Exception() << "Can not resize a read-only memory mapped NPY file";
+    }
+    // Generate header, re-using the space already reserved
     std::stringstream header;
-    writeNpyHeader<T>(header, shape, m_attr_names);
+    auto header_size = writeNpyHeaderBlock(header, npyHeaderDict<T>(shape, m_attr_names), m_data_offset);
     auto header_str  = header.str();
-    auto header_size = header_str.size();
     // Make sure we are in place
     if (header_size != m_data_offset) {
       throw Elements::Exception() << "Can not resize memory mapped NPY file. "
                                      "The new header length must match the allocated space.";
     }
 
-    m_n_elements    = std::accumulate(shape.begin(), shape.end(), 1u, std::multiplies<size_t>());
-    size_t new_size = header_size + sizeof(T) * m_n_elements;
-    if (new_size > m_max_size) {
-      throw Elements::Exception() << "resize request bigger than maximum allocated size: " << new_size << " > " << m_max_size;
+    size_t n_elements = std::accumulate(shape.begin(), shape.end(), size_t{1}, std::multiplies<size_t>());
+    size_t new_size   = header_size + sizeof(T) * n_elements;
+    if (new_size > m_file->capacity) {
+      grow(new_size);
+    } else if (m_file->mapped.flags() != boost::iostreams::mapped_file_base::readwrite) {
+      boost::filesystem::resize_file(m_file->path, new_size);
+    }
+    m_n_elements = n_elements;
+    m_file->used = new_size;
+    std::copy(header_str.begin(), header_str.end(), m_file->mapped.data());
+  }
+
+  /// Extend the file in advance, so it can grow up to the given shape without being mapped again
+  void reserve(const std::vector<size_t>& shape) {
+    size_t n_elements = std::accumulate(shape.begin(), shape.end(), size_t{1}, std::multiplies<size_t>());
+    size_t new_size   = m_data_offset + sizeof(T) * n_elements;
+    if (new_size > m_file->capacity && m_file->mapped.flags() == boost::iostreams::mapped_file_base::readwrite) {
+      grow(new_size);
+    }
+  }
+
+  /// Copy the data into memory, as copies of the container share the mapping
+  std::vector<T> copyToMemory() const {
+    return std::vector<T>(m_data, m_data + m_n_elements);
+  }
+
+  /**
+   * Forward the access pattern of the elements in [begin, end) to the kernel. The range is extended to
+   * whole pages.
+   * @note
+   *    MemoryAdvice::DONTNEED is ignored for private mappings, as the kernel would discard the modifications.
+   */
+  void advise(MemoryAdvice advice, size_t begin, size_t end) {
+    if (begin >= end)
+      return;
+    int flag;
+    switch (advice) {
+    case MemoryAdvice::SEQUENTIAL:
+      flag = MADV_SEQUENTIAL;
+      break;
+    case MemoryAdvice::RANDOM:
+      flag = MADV_RANDOM;
+      break;
+    case MemoryAdvice::WILLNEED:
+      flag = MADV_WILLNEED;
+      break;
+    case MemoryAdvice::DONTNEED:
+      if (m_file->mapped.flags() == boost::iostreams::mapped_file_base::priv)
+        return;
+      flag = MADV_DONTNEED;
+      break;
+    default:
+      flag = MADV_NORMAL;
+    }
+    static const size_t page_size = sysconf(_SC_PAGESIZE);
+
+    // The mapping starts at the beginning of the file, so it is page aligned
+    const char* base  = m_file->mapped.const_data();
+    size_t      first = m_data_offset + begin * sizeof(T);
+    size_t      last  = std::min(m_data_offset + end * sizeof(T), m_file->used);
+    first -= first % page_size;
+    if (first >= last)
+      return;
+    if (::madvise(const_cast<char*>(base) + first, last - first, flag) != 0) {
+      throw Elements::Exception() << "Failed to advise the kernel about " << m_file->path << ": "
+                                  << std::strerror(errno);
     }
-    boost::filesystem::resize_file(m_path, new_size);
-    std::copy(header_str.begin(), header_str.end(), m_mapped.data());
   }
 
 private:
-  boost::filesystem::path       m_path;
-  size_t                        m_data_offset, m_n_elements, m_max_size;
-  std::vector<std::string>      m_attr_names;
-  boost::iostreams::mapped_file m_mapped;
-  T*                            m_data;
+  /// Mapping shared by all the copies of the container
+  struct File {
+    boost::filesystem::path       path;
+    boost::iostreams::mapped_file mapped;
+    size_t                        capacity, used;
+    bool                          extended;
+
+    File(const boost::filesystem::path& path_, boost::iostreams::mapped_file&& mapped_, size_t capacity_, size_t used_)
+        : path(path_), mapped(std::move(mapped_)), capacity(capacity_), used(used_), extended(false) {
+      if (mapped.flags() == boost::iostreams::mapped_file_base::readwrite) {
+        extended = boost::filesystem::file_size(path) > used;
+      }
+    }
+
+    ~File() {
+      mapped.close();
+      if (extended) {
+        boost::system::error_code ec;
+        boost::filesystem::resize_file(path, used, ec);
+      }
+    }
+  };
+
+  size_t                   m_data_offset, m_n_elements;
+  std::vector<std::string> m_attr_names;
+  std::shared_ptr<File>    m_file;
+  T*                       m_data;
+
+  /// Extend the file and map it again, at least doubling the capacity
+  void grow(size_t min_size) {
+    if (m_file->mapped.flags() != boost::iostreams::mapped_file_base::readwrite) {
+      throw Elements::Exception() << "resize request bigger than maximum allocated size: " << min_size << " > "
+                                  << m_file->capacity;
+    }
+    size_t capacity = std::max(min_size, 2 * m_file->capacity);
+
+    m_file->mapped.close();
+    boost::filesystem::resize_file(m_file->path, capacity);
+    m_file->extended = true;
+
+    boost::iostreams::mapped_file_params map_params;
+    map_params.path  = m_file->path.native();
+    map_params.flags = boost::iostreams::mapped_file_base::readwrite;
+    m_file->mapped.open(map_params);
+    m_file->capacity = capacity;
+    m_data           = reinterpret_cast<T*>(m_file->mapped.data() + m_data_offset);
+  }
 };
 
 }  // end of namespace NdArray
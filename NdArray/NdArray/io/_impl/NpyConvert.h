@@ -0,0 +1,232 @@
+/*
+ * Copyright (C) 2012-2020 Euclid Science Ground Segment
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#ifndef ALEXANDRIA_NDARRAY_IMPL_NPYCONVERT_H
+#define ALEXANDRIA_NDARRAY_IMPL_NPYCONVERT_H
+
+#include "NpyCommon.h"
+#include <ElementsKernel/Exception.h>
+#include <algorithm>
+#include <cstring>
+#include <boost/endian/conversion.hpp>
+#include <istream>
+#include <limits>
+#include <type_traits>
+#include <vector>
+
+namespace Euclid {
+namespace NdArray {
+
+/**
+ * Size, in bytes, of the staging buffer used when the stored dtype needs to be converted
+ */
+constexpr size_t NPY_CONVERT_BUFFER_SIZE = 1 << 20;
+
+/**
+ * Types that can be stored in, and read from, npy files
+ */
+#define NPY_SUPPORTED_TYPES int8_t, uint8_t, int16_t, uint16_t, int32_t, uint32_t, int64_t, uint64_t, float, double, Float16
+
+/**
+ * Floating point types, including those only used for storage
+ */
+template <typename T>
+struct NpyIsFloat : std::integral_constant<bool, std::is_floating_point<T>::value || std::is_same<T, Float16>::value> {};
+
+/**
+ * True if every value of From can be represented exactly as To, following numpy "safe" casting rules
+ * (i.e. int16 to int32, uint16 to int32, int32 to double or float to double)
+ */
+template <typename From, typename To>
+struct NpySafeCast
+    : std::integral_constant<
+          bool, std::is_same<From, To>::value ||
+                    (std::is_integral<From>::value && std::is_integral<To>::value &&
+                     ((std::is_signed<From>::value == std::is_signed<To>::value && sizeof(To) >= sizeof(From)) ||
+                      (std::is_unsigned<From>::value && std::is_signed<To>::value && sizeof(To) > sizeof(From)))) ||
+                    (std::is_integral<From>::value && NpyIsFloat<To>::value &&
+                     std::numeric_limits<From>::digits <= std::numeric_limits<To>::digits) ||
+                    (NpyIsFloat<From>::value && NpyIsFloat<To>::value && sizeof(To) >= sizeof(From))> {};
+
+/**
+ * Reverse in place the byte order of n values. Written as a plain loop over the values,
+ * which compilers turn into vectorized byte shuffles.
+ */
+template <typename T>
+void byteSwapInPlace(T* data, size_t n) {
+  typedef typename std::conditional<
+      sizeof(T) == 8, uint64_t,
+      typename std::conditional<sizeof(T) == 4, uint32_t, typename std::conditional<sizeof(T) == 2, uint16_t, uint8_t>::type>::type>::type
+          Word;
+  static_assert(sizeof(Word) == sizeof(T), "Unsupported type size");
+
+  if (sizeof(T) == 1)
+    return;
+  auto words = reinterpret_cast<Word*>(data);
+  for (size_t i = 0; i < n; ++i) {
+    words[i] = boost::endian::endian_reverse(words[i]);
+  }
+}
+
+/**
+ * Read n values stored as From, converting them into To
+ */
+template <typename From, typename To, bool Safe = NpySafeCast<From, To>::value>
+struct NpyConvert {
+  static void read(std::istream& input, bool swap, To* out, size_t n) {
+    if (std::is_same<From, To>::value) {
+      input.read(reinterpret_cast<char*>(out), n * sizeof(To));
+      if (swap)
+        byteSwapInPlace(out, n);
+      return;
+    }
+    // Convert in blocks, so the staging area stays small and in cache
+    std::vector<From> buffer(std::min(n, NPY_CONVERT_BUFFER_SIZE / sizeof(From)));
+    for (size_t done = 0; done < n;) {
+      size_t block = std::min(buffer.size(), n - done);
+      input.read(reinterpret_cast<char*>(buffer.data()), block * sizeof(From));
+      if (swap)
+        byteSwapInPlace(buffer.data(), block);
+      convertValues(static_cast<const From*>(buffer.data()), out + done, block);
+      done += block;
+    }
+  }
+
+  /// Gather n_records blocks of per_record contiguous values, separated by record_size bytes
+  static void gather(const char* src, size_t n_records, size_t record_size, size_t per_record, bool swap, To* out) {
+    for (size_t r = 0; r < n_records; ++r, src += record_size) {
+      for (size_t i = 0; i < per_record; ++i) {
+        From value;
+        std::memcpy(&value, src + i * sizeof(From), sizeof(From));
+        if (swap)
+          byteSwapInPlace(&value, 1);
+        *out++ = value;
+      }
+    }
+  }
+};
+
+template <typename From, typename To>
+struct NpyConvert<From, To, false> {
+  static void read(std::istream&, bool, To*, size_t) {
+    fail();
+  }
+
+  static void gather(const char*, size_t, size_t, size_t, bool, To*) {
+    fail();
+  }
+
+  static void fail() {
+    throw Elements::Exception() << "Can not cast " << std::string(NpyDtype<From>::str) << " into "
+                                << std::string(NpyDtype<To>::str);
+  }
+};
+
+/**
+ * Find the stored type among the supported ones, and convert from it
+ */
+template <typename To, typename... From>
+struct NpyConvertDispatch;
+
+template <typename To>
+struct NpyConvertDispatch<To> {
+  static void read(std::istream&, const std::string& dtype, bool, To*, size_t) {
+    throw Elements::Exception() << "Can not cast " << dtype << " into " << typeid(To).name();
+  }
+
+  static void gather(const std::string& dtype, const char*, size_t, size_t, size_t, bool, To*) {
+    throw Elements::Exception() << "Can not cast " << dtype << " into " << typeid(To).name();
+  }
+};
+
+template <typename To, typename From, typename... Rest>
+struct NpyConvertDispatch<To, From, Rest...> {
+  static void read(std::istream& input, const std::string& dtype, bool swap, To* out, size_t n) {
+    if (isNpyDtype<From>(dtype))
+      NpyConvert<From, To>::read(input, swap, out, n);
+    else
+      NpyConvertDispatch<To, Rest...>::read(input, dtype, swap, out, n);
+  }
+
+  static void gather(const std::string& dtype, const char* src, size_t n_records, size_t record_size, size_t per_record,
+                     bool swap, To* out) {
+    if (isNpyDtype<From>(dtype))
+      NpyConvert<From, To>::gather(src, n_records, record_size, per_record, swap, out);
+    else
+      NpyConvertDispatch<To, Rest...>::gather(dtype, src, n_records, record_size, per_record, swap, out);
+  }
+};
+
+/**
+ * Read the data of an npy file directly into the destination buffer, swapping the byte order and converting
+ * the type if needed
+ * @param input
+ *  Input stream, positioned after the header
+ * @param dtype
+ *  Stored dtype, as read from the header
+ * @param big_endian
+ *  True if the stored data is big-endian
+ * @param out
+ *  Destination buffer
+ * @param n
+ *  Number of values
+ * @throws Elements::Exception
+ *  If the stored type can not be safely converted into T
+ */
+template <typename T>
+void readNpyData(std::istream& input, const std::string& dtype, bool big_endian, T* out, size_t n) {
+  bool swap = (big_endian != (BYTE_ORDER == BIG_ENDIAN));
+  // Shortcut for the most common case
+  if (isNpyDtype<T>(dtype)) {
+    NpyConvert<T, T>::read(input, swap, out, n);
+    return;
+  }
+  NpyConvertDispatch<T, NPY_SUPPORTED_TYPES>::read(input, dtype, swap, out, n);
+}
+
+/**
+ * Copy values stored inside records (i.e. a field of a structured array), swapping the byte order and converting
+ * the type if needed
+ * @param dtype
+ *  Stored dtype
+ * @param big_endian
+ *  True if the stored data is big-endian
+ * @param src
+ *  Address of the first value of the first record
+ * @param n_records
+ *  Number of records
+ * @param record_size
+ *  Size in bytes of a record
+ * @param per_record
+ *  Number of contiguous values to copy from each record
+ * @param out
+ *  Destination buffer, with room for n_records * per_record values
+ * @throws Elements::Exception
+ *  If the stored type can not be safely converted into T
+ */
+template <typename T>
+void gatherNpyData(const std::string& dtype, bool big_endian, const char* src, size_t n_records, size_t record_size,
+                   size_t per_record, T* out) {
+  bool swap = (big_endian != (BYTE_ORDER == BIG_ENDIAN));
+  NpyConvertDispatch<T, NPY_SUPPORTED_TYPES>::gather(dtype, src, n_records, record_size, per_record, swap, out);
+}
+
+}  // end of namespace NdArray
+}  // end of namespace Euclid
+
+#endif  // ALEXANDRIA_NDARRAY_IMPL_NPYCONVERT_H
@@ -0,0 +1,77 @@
+/*
+ * Copyright (C) 2012-2020 Euclid Science Ground Segment
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#ifndef ALEXANDRIA_NDARRAY_IMPL_NPZCOMMON_H
+#define ALEXANDRIA_NDARRAY_IMPL_NPZCOMMON_H
+
+#include <boost/endian/arithmetic.hpp>
+#include <cstring>
+#include <ostream>
+
+namespace Euclid {
+namespace NdArray {
+
+/**
+ * Zip record signatures and constants
+ * @see
+ *  https://pkware.cachefly.net/webdocs/casestudies/APPNOTE.TXT
+ */
+constexpr uint32_t ZIP_LOCAL_HEADER_SIG      = 0x04034b50;
+constexpr uint32_t ZIP_CENTRAL_HEADER_SIG    = 0x02014b50;
+constexpr uint32_t ZIP_END_RECORD_SIG        = 0x06054b50;
+constexpr uint32_t ZIP64_END_RECORD_SIG      = 0x06064b50;
+constexpr uint32_t ZIP64_END_LOCATOR_SIG     = 0x07064b50;
+constexpr uint16_t ZIP64_EXTRA_ID            = 0x0001;
+constexpr uint16_t ZIP_ALIGNMENT_EXTRA_ID    = 0xd935;
+constexpr uint16_t ZIP_VERSION_ZIP64         = 45;
+constexpr uint16_t ZIP_METHOD_STORED         = 0;
+constexpr uint16_t ZIP_METHOD_DEFLATED       = 8;
+constexpr uint32_t ZIP_32_LIMIT              = 0xffffffff;
+constexpr size_t   ZIP_LOCAL_HEADER_SIZE     = 30;
+constexpr size_t   ZIP_CENTRAL_HEADER_SIZE   = 46;
+constexpr size_t   ZIP_END_RECORD_SIZE       = 22;
+constexpr size_t   ZIP64_END_LOCATOR_SIZE    = 20;
+constexpr size_t   NPZ_DATA_ALIGNMENT        = 64;
+
+/**
+ * Read a little endian integer from an unaligned address
+ * @tparam E
+ *  A boost::endian little endian arithmetic type
+ */
+template <typename E>
+typename E::value_type zipLoad(const char* ptr) {
+  E value;
+  std::memcpy(&value, ptr, sizeof(value));
+  return value;
+}
+
+/**
+ * Write a little endian integer
+ * @tparam E
+ *  A boost::endian little endian arithmetic type
+ */
+template <typename E>
+void zipStore(std::ostream& out, typename E::value_type value) {
+  E little = value;
+  out.write(reinterpret_cast<const char*>(&little), sizeof(little));
+}
+
+}  // end of namespace NdArray
+}  // end of namespace Euclid
+
+#endif  // ALEXANDRIA_NDARRAY_IMPL_NPZCOMMON_H
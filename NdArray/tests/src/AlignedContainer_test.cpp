@@ -0,0 +1,100 @@
+/*
+ * Copyright (C) 2012-2020 Euclid Science Ground Segment
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#include "NdArray/AlignedContainer.h"
+#include <boost/test/unit_test.hpp>
+#include <cstdint>
+
+using namespace Euclid::NdArray;
+
+BOOST_AUTO_TEST_SUITE(AlignedContainer_test)
+
+BOOST_AUTO_TEST_CASE(Alignment_test) {
+  for (size_t alignment : {16, 32, 64, 128}) {
+    auto array = createAligned<float>({10, 3}, alignment);
+    BOOST_CHECK_EQUAL(reinterpret_cast<std::uintptr_t>(array.data()) % alignment, 0);
+    BOOST_CHECK(array.isContiguous());
+    BOOST_CHECK_EQUAL(array.size(), 30);
+    for (auto v : array) {
+      BOOST_CHECK_EQUAL(v, 0.f);
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(BadAlignment_test) {
+  BOOST_CHECK_THROW(AlignedContainer<double>({10}, 3), std::invalid_argument);
+  BOOST_CHECK_THROW(AlignedContainer<double>({10}, 48), std::invalid_argument);
+  BOOST_CHECK_THROW(AlignedContainer<double>({10}, 64, 12), std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_CASE(Padding_test) {
+  auto array = createAligned<double>({5, 3}, 32, 32);
+
+  BOOST_CHECK(!array.isContiguous());
+  BOOST_CHECK_EQUAL(array.size(), 15);
+  BOOST_CHECK_EQUAL(array.strides()[0], 4);
+  BOOST_CHECK_EQUAL(array.strides()[1], 1);
+
+  int i = 0;
+  for (auto& v : array) {
+    v = i++;
+  }
+  for (size_t row = 0; row < 5; ++row) {
+    BOOST_CHECK_EQUAL(reinterpret_cast<std::uintptr_t>(&array.at(row, 0)) % 32, 0);
+    for (size_t col = 0; col < 3; ++col) {
+      BOOST_CHECK_EQUAL(array.at(row, col), row * 3 + col);
+      BOOST_CHECK_EQUAL(array.data()[row * array.strides()[0] + col], row * 3 + col);
+    }
+  }
+
+  auto iter = array.begin() + 7;
+  BOOST_CHECK_EQUAL(*iter, 7);
+  BOOST_CHECK_EQUAL(array.end() - array.begin(), 15);
+
+  BOOST_CHECK_THROW(array.reshape(15), std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_CASE(PaddedCopy_test) {
+  auto array = createAligned<int32_t>({4, 5}, 64, 64);
+  std::iota(array.begin(), array.end(), 0);
+
+  auto copy = array.copy();
+  BOOST_CHECK_EQUAL_COLLECTIONS(array.begin(), array.end(), copy.begin(), copy.end());
+  BOOST_CHECK(copy == array);
+  copy.at(2, 2) = -1;
+  BOOST_CHECK_EQUAL(array.at(2, 2), 12);
+}
+
+BOOST_AUTO_TEST_CASE(PaddedConcatenate_test) {
+  auto array = createAligned<float>({2, 3}, 64, 16);
+  std::iota(array.begin(), array.end(), 0);
+
+  NdArray<float> other({3, 3});
+  std::iota(other.begin(), other.end(), 6);
+
+  array.concatenate(other);
+  BOOST_CHECK_EQUAL(array.shape()[0], 5);
+  BOOST_CHECK_EQUAL(array.size(), 15);
+  BOOST_CHECK_EQUAL(array.strides()[0], 4);
+
+  std::vector<float> expected(15);
+  std::iota(expected.begin(), expected.end(), 0);
+  BOOST_CHECK_EQUAL_COLLECTIONS(expected.begin(), expected.end(), array.begin(), array.end());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
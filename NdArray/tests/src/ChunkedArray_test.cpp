@@ -0,0 +1,175 @@
+/*
+ * Copyright (C) 2012-2020 Euclid Science Ground Segment
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#include "NdArray/io/ChunkedArray.h"
+#include <ElementsKernel/Exception.h>
+#include <ElementsKernel/Temporary.h>
+#include <boost/filesystem/operations.hpp>
+#include <boost/test/unit_test.hpp>
+
+using namespace Euclid::NdArray;
+
+struct ChunkedArray_Fixture {
+  Elements::TempDir   dir{"chunked_%%%%"};
+  NdArray<int32_t>    reference{std::vector<size_t>{25, 30, 7}};
+  std::vector<size_t> chunk_shape{8, 8, 4};
+
+  ChunkedArray_Fixture() {
+    std::iota(reference.begin(), reference.end(), 0);
+  }
+};
+
+BOOST_AUTO_TEST_SUITE(ChunkedArray_test)
+
+//-----------------------------------------------------------------------------
+
+BOOST_FIXTURE_TEST_CASE(WriteRead_test, ChunkedArray_Fixture) {
+  auto path = dir.path() / "array";
+  {
+    ChunkedArray<int32_t> chunked(path, reference.shape(), chunk_shape);
+    BOOST_CHECK_EQUAL(chunked.size(), reference.size());
+    auto grid = chunked.gridShape();
+    BOOST_CHECK_EQUAL(grid[0], 4);
+    BOOST_CHECK_EQUAL(grid[1], 4);
+    BOOST_CHECK_EQUAL(grid[2], 2);
+    // Never written, so they read as 0
+    BOOST_CHECK_EQUAL(chunked.get({24, 29, 6}), 0);
+    chunked.write({0, 0, 0}, reference);
+  }
+  // All tiles are on disk
+  BOOST_CHECK(boost::filesystem::exists(path / "3.3.1"));
+
+  ChunkedArray<int32_t> chunked(path);
+  auto                  shape = chunked.shape();
+  BOOST_CHECK_EQUAL(shape.size(), 3);
+  BOOST_CHECK_EQUAL(shape[0], 25);
+  BOOST_CHECK_EQUAL(shape[1], 30);
+  BOOST_CHECK_EQUAL(shape[2], 7);
+  BOOST_CHECK_EQUAL(chunked.compressionLevel(), 0);
+
+  auto full = chunked.read({0, 0, 0}, shape);
+  BOOST_CHECK(full == reference);
+
+  auto region = chunked.read({5, 7, 2}, {10, 12, 5});
+  for (size_t i = 0; i < 10; ++i) {
+    for (size_t j = 0; j < 12; ++j) {
+      for (size_t k = 0; k < 5; ++k) {
+        BOOST_CHECK_EQUAL(region.at(i, j, k), reference.at(i + 5, j + 7, k + 2));
+      }
+    }
+  }
+  BOOST_CHECK_EQUAL(chunked.get({24, 29, 6}), reference.at(24, 29, 6));
+
+  BOOST_CHECK_THROW(chunked.read({20, 0, 0}, {10, 1, 1}), std::out_of_range);
+  BOOST_CHECK_THROW(chunked.read({0, 0}, {1, 1}), std::out_of_range);
+  BOOST_CHECK_THROW(ChunkedArray<double>{path}, Elements::Exception);
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_FIXTURE_TEST_CASE(Compressed_test, ChunkedArray_Fixture) {
+  auto path = dir.path() / "compressed";
+  {
+    ChunkedArray<int32_t> chunked(path, reference.shape(), chunk_shape, 6);
+    chunked.write({0, 0, 0}, reference);
+  }
+  // Consecutive integers compress well
+  BOOST_CHECK_LT(boost::filesystem::file_size(path / "0.0.0"), 8 * 8 * 4 * sizeof(int32_t));
+
+  ChunkedArray<int32_t> chunked(path);
+  BOOST_CHECK_EQUAL(chunked.compressionLevel(), 6);
+  BOOST_CHECK(chunked.read({0, 0, 0}, chunked.shape()) == reference);
+
+  BOOST_CHECK_THROW(ChunkedArray<int32_t>(path, {10}, {5}, 10), std::invalid_argument);
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_FIXTURE_TEST_CASE(BoundedCache_test, ChunkedArray_Fixture) {
+  auto path = dir.path() / "cache";
+  {
+    ChunkedArray<int32_t> chunked(path, reference.shape(), chunk_shape, 0, 2);
+    chunked.write({0, 0, 0}, reference);
+    BOOST_CHECK_LE(chunked.cachedTiles(), 2);
+  }
+
+  ChunkedArray<int32_t> chunked(path, 4);
+
+  // A line along the first axis only touches the tiles it crosses
+  auto column = chunked.read({0, 10, 3}, {25, 1, 1});
+  BOOST_CHECK_EQUAL(chunked.tileLoads(), 4);
+  for (size_t i = 0; i < 25; ++i) {
+    BOOST_CHECK_EQUAL(column.at(i, 0, 0), reference.at(i, 10, 3));
+  }
+
+  // Same line again, served from the cache
+  chunked.read({0, 10, 3}, {25, 1, 1});
+  BOOST_CHECK_EQUAL(chunked.tileLoads(), 4);
+
+  // A line along the last axis
+  chunked.read({3, 3, 0}, {1, 1, 7});
+  BOOST_CHECK_EQUAL(chunked.tileLoads(), 6);
+  BOOST_CHECK_EQUAL(chunked.cachedTiles(), 4);
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_FIXTURE_TEST_CASE(Tile_test, ChunkedArray_Fixture) {
+  auto path = dir.path() / "tiles";
+  {
+    ChunkedArray<int32_t> chunked(path, reference.shape(), chunk_shape, 0, 1);
+    chunked.write({0, 0, 0}, reference);
+
+    // Border tile, clipped to the array
+    auto tile  = chunked.tile({3, 1, 1});
+    auto shape = tile.shape();
+    BOOST_CHECK_EQUAL(shape[0], 1);
+    BOOST_CHECK_EQUAL(shape[1], 8);
+    BOOST_CHECK_EQUAL(shape[2], 3);
+    BOOST_CHECK_EQUAL(tile.at(0, 2, 1), reference.at(24, 10, 5));
+
+    // Pinned: accessing other tiles does not evict it
+    chunked.read({0, 0, 0}, {16, 16, 4});
+    BOOST_CHECK_EQUAL(chunked.cachedTiles(), 2);
+    tile.at(0, 2, 1) = -1;
+    chunked.flush();
+    tile.at(0, 0, 0) = -2;
+  }
+
+  ChunkedArray<int32_t> chunked(path);
+  BOOST_CHECK_EQUAL(chunked.get({24, 10, 5}), -1);
+  BOOST_CHECK_EQUAL(chunked.get({24, 8, 4}), -2);
+  BOOST_CHECK_THROW(chunked.tile({4, 0, 0}), std::out_of_range);
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_FIXTURE_TEST_CASE(NonContiguous_test, ChunkedArray_Fixture) {
+  auto                  path = dir.path() / "transposed";
+  ChunkedArray<int32_t> chunked(path, {7, 30, 25}, {4, 8, 8});
+  chunked.write({0, 0, 0}, reference.transpose());
+  chunked.set({0, 0, 0}, 42);
+
+  auto read = chunked.read({0, 0, 0}, chunked.shape());
+  BOOST_CHECK_EQUAL(read.at(0, 0, 0), 42);
+  BOOST_CHECK_EQUAL(read.at(3, 20, 10), reference.at(10, 20, 3));
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,149 @@
+/*
+ * Copyright (C) 2012-2020 Euclid Science Ground Segment
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#include "NdArray/Compare.h"
+#include <boost/test/unit_test.hpp>
+#include <cmath>
+#include <limits>
+
+using namespace Euclid::NdArray;
+
+struct Compare_Fixture {
+  NdArray<double> a{std::vector<size_t>{300, 500, 2}};
+  NdArray<double> b{std::vector<size_t>{300, 500, 2}};
+
+  Compare_Fixture() {
+    std::iota(a.begin(), a.end(), 0.);
+    std::iota(b.begin(), b.end(), 0.);
+  }
+};
+
+BOOST_AUTO_TEST_SUITE(Compare_test)
+
+//-----------------------------------------------------------------------------
+
+BOOST_FIXTURE_TEST_CASE(Exact_test, Compare_Fixture) {
+  for (unsigned int n_threads : {1u, 4u}) {
+    auto result = compare(a, b, Tolerance::exact(), n_threads);
+    BOOST_CHECK(result);
+    BOOST_CHECK_EQUAL(result.mismatches, 0);
+    BOOST_CHECK(result.first_mismatch.empty());
+  }
+
+  b.at(250, 10, 1) += 1;
+  b.at(20, 499, 0) += 1;
+  b.at(299, 499, 1) += 1;
+  for (unsigned int n_threads : {1u, 4u}) {
+    auto result = compare(a, b, Tolerance::exact(), n_threads);
+    BOOST_CHECK(!result);
+    BOOST_CHECK(result.same_shape);
+    BOOST_CHECK_EQUAL(result.mismatches, 3);
+    BOOST_CHECK(result.first_mismatch == std::vector<size_t>({20, 499, 0}));
+  }
+
+  // The first mismatch is always found, even if the count stops early
+  for (unsigned int n_threads : {1u, 4u}) {
+    auto result = compare(a, b, Tolerance::exact(), n_threads, true);
+    BOOST_CHECK(!result);
+    BOOST_CHECK_GE(result.mismatches, 1);
+    BOOST_CHECK(result.first_mismatch == std::vector<size_t>({20, 499, 0}));
+  }
+
+  BOOST_CHECK(a != b);
+  BOOST_CHECK(!compare(a, NdArray<double>({300, 1000})).same_shape);
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_FIXTURE_TEST_CASE(NaN_test, Compare_Fixture) {
+  a.at(5, 5, 0) = b.at(5, 5, 0) = std::numeric_limits<double>::quiet_NaN();
+  BOOST_CHECK_EQUAL(compare(a, b).mismatches, 1);
+  BOOST_CHECK(compare(a, b, Tolerance::exact(true)));
+  BOOST_CHECK(compare(a, b, Tolerance::ulps(0, true)));
+  BOOST_CHECK(!compare(a, b, Tolerance::relativeTo(0.1)));
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_FIXTURE_TEST_CASE(Ulps_test, Compare_Fixture) {
+  b.at(1, 2, 1)    = std::nextafter(std::nextafter(a.at(1, 2, 1), 1e9), 1e9);
+  b.at(100, 0, 0)  = std::nextafter(a.at(100, 0, 0), 0.);
+  b.at(0, 0, 0)    = -0.;
+  b.at(200, 1, 1) += 1e-3;
+
+  auto result = compare(a, b, Tolerance::ulps(1), 3);
+  BOOST_CHECK_EQUAL(result.mismatches, 2);
+  BOOST_CHECK(result.first_mismatch == std::vector<size_t>({1, 2, 1}));
+  BOOST_CHECK_EQUAL(compare(a, b, Tolerance::ulps(2), 3).mismatches, 1);
+
+  // Integers
+  NdArray<int32_t> i({3}, std::vector<int32_t>{-5, 0, 10});
+  NdArray<int32_t> j({3}, std::vector<int32_t>{-3, 1, 10});
+  BOOST_CHECK(compare(i, j, Tolerance::ulps(2)));
+  BOOST_CHECK(compare(i, j, Tolerance::ulps(1)).first_mismatch == std::vector<size_t>({0}));
+
+  // The distance between the limits does not fit in the type
+  NdArray<int32_t> low({2}, std::vector<int32_t>{std::numeric_limits<int32_t>::min(), -1});
+  NdArray<int32_t> high({2}, std::vector<int32_t>{std::numeric_limits<int32_t>::max(), -1});
+  BOOST_CHECK_EQUAL(compare(low, high, Tolerance::ulps(std::numeric_limits<uint32_t>::max() - 1)).mismatches, 1);
+  BOOST_CHECK(compare(low, high, Tolerance::ulps(std::numeric_limits<uint32_t>::max())));
+  NdArray<int64_t> low64({1}, std::vector<int64_t>{std::numeric_limits<int64_t>::min()});
+  NdArray<int64_t> high64({1}, std::vector<int64_t>{std::numeric_limits<int64_t>::max()});
+  BOOST_CHECK(compare(low64, high64, Tolerance::ulps(std::numeric_limits<uint64_t>::max())));
+  BOOST_CHECK(!compare(high64, low64, Tolerance::ulps(std::numeric_limits<uint64_t>::max() - 1)));
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_FIXTURE_TEST_CASE(Relative_test, Compare_Fixture) {
+  std::transform(a.begin(), a.end(), b.begin(), [](double v) { return v * (1 + 1e-7); });
+  BOOST_CHECK(!allClose(a, b));
+  BOOST_CHECK(allClose(a, b, 1e-6, 0., 4));
+
+  // Close to 0, the absolute tolerance is needed
+  b.at(0, 0, 0) = 1e-12;
+  BOOST_CHECK(!allClose(a, b, 1e-6));
+  BOOST_CHECK(allClose(a, b, 1e-6, 1e-10));
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_FIXTURE_TEST_CASE(NonContiguous_test, Compare_Fixture) {
+  auto t = a.transpose();
+  auto c = t.copy();
+  BOOST_CHECK(compare(t, c, Tolerance::exact(), 2));
+
+  c.at(1, 7, 12) = -1;
+  auto result = compare(t, c, Tolerance::relativeTo(1e-3), 2);
+  BOOST_CHECK_EQUAL(result.mismatches, 1);
+  BOOST_CHECK(result.first_mismatch == std::vector<size_t>({1, 7, 12}));
+  BOOST_CHECK(t != c);
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_CASE(NonArithmetic_test) {
+  NdArray<std::string> a({2}, std::vector<std::string>{"a", "b"});
+  NdArray<std::string> b({2}, std::vector<std::string>{"a", "c"});
+  BOOST_CHECK(compare(a, b).first_mismatch == std::vector<size_t>({1}));
+  BOOST_CHECK_THROW(compare(a, b, Tolerance::ulps(1)), std::invalid_argument);
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,238 @@
+/*
+ * Copyright (C) 2012-2020 Euclid Science Ground Segment
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#include "NdArray/LinearAlgebra.h"
+#include <boost/test/unit_test.hpp>
+#include <cmath>
+#include <random>
+
+using namespace Euclid::NdArray;
+
+template <typename T>
+static NdArray<T> randomArray(const std::vector<size_t>& shape, unsigned seed) {
+  std::mt19937                      rng(seed);
+  std::uniform_real_distribution<T> dist(-1, 1);
+  NdArray<T>                        array(shape);
+  std::generate(array.begin(), array.end(), [&]() { return dist(rng); });
+  return array;
+}
+
+template <typename T>
+static NdArray<T> naiveProduct(const NdArray<T>& a, const NdArray<T>& b) {
+  NdArray<T> c(std::vector<size_t>{a.shape()[0], b.shape()[1]});
+  for (size_t i = 0; i < a.shape()[0]; ++i) {
+    for (size_t j = 0; j < b.shape()[1]; ++j) {
+      double sum = 0;
+      for (size_t k = 0; k < a.shape()[1]; ++k) {
+        sum += a.at(i, k) * b.at(k, j);
+      }
+      c.at(i, j) = sum;
+    }
+  }
+  return c;
+}
+
+template <typename T>
+static void checkClose(const NdArray<T>& a, const NdArray<T>& b, double tolerance) {
+  BOOST_REQUIRE(a.shape() == b.shape());
+  auto i = a.begin();
+  auto j = b.begin();
+  for (; i != a.end(); ++i, ++j) {
+    BOOST_CHECK_SMALL(static_cast<double>(*i - *j), tolerance);
+  }
+}
+
+BOOST_AUTO_TEST_SUITE(LinearAlgebra_test)
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_CASE(Gemm_test) {
+  // Sizes not multiple of any block size, and big enough to be split between threads
+  auto a        = randomArray<double>({203, 151}, 1);
+  auto b        = randomArray<double>({151, 97}, 2);
+  auto expected = naiveProduct(a, b);
+
+  for (unsigned int n_threads : {1u, 3u}) {
+    checkClose(matmul(a, b, n_threads), expected, 1e-12);
+  }
+
+  // C = 2 * A * B - C
+  auto c = randomArray<double>({203, 97}, 3);
+  auto d = c.copy();
+  gemm(2., a, b, -1., c);
+  for (size_t i = 0; i < 203; ++i) {
+    for (size_t j = 0; j < 97; ++j) {
+      BOOST_CHECK_SMALL(c.at(i, j) - (2 * expected.at(i, j) - d.at(i, j)), 1e-12);
+    }
+  }
+
+  BOOST_CHECK_THROW(matmul(a, a), std::length_error);
+  BOOST_CHECK_THROW(matmul(a, NdArray<double>({151})), std::length_error);
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_CASE(GemmViews_test) {
+  // Operands are transposed views
+  auto a_t      = randomArray<float>({40, 70}, 4);
+  auto b_t      = randomArray<float>({33, 40}, 5);
+  auto a        = a_t.transpose();
+  auto b        = b_t.transpose();
+  auto expected = naiveProduct(a, b);
+  checkClose(matmul(a, b), expected, 1e-4);
+
+  // The output is a transposed view as well
+  NdArray<float> c_t({33, 70});
+  auto           c = c_t.transpose();
+  gemm(1.f, a, b, 0.f, c);
+  checkClose(c, expected, 1e-4);
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_CASE(Gemv_test) {
+  auto a = randomArray<double>({1000, 1200}, 6);
+  auto x = randomArray<double>({1200}, 7);
+
+  NdArray<double> expected({1000});
+  for (size_t i = 0; i < 1000; ++i) {
+    double sum = 0;
+    for (size_t j = 0; j < 1200; ++j) {
+      sum += a.at(i, j) * x.at(j);
+    }
+    expected.at(i) = sum;
+  }
+
+  for (unsigned int n_threads : {1u, 4u}) {
+    checkClose(matvec(a, x, n_threads), expected, 1e-10);
+  }
+
+  // Column-major layout
+  auto a_t = a.transpose().transpose();
+  auto col = NdArray<double>(std::vector<size_t>{1200, 1000});
+  for (size_t i = 0; i < 1000; ++i) {
+    for (size_t j = 0; j < 1200; ++j) {
+      col.at(j, i) = a.at(i, j);
+    }
+  }
+  checkClose(matvec(col.transpose(), x, 2), expected, 1e-10);
+  checkClose(matvec(a_t, x), expected, 1e-10);
+
+  // y = A * x + 2 * y
+  NdArray<double> y({1000});
+  std::fill(y.begin(), y.end(), 1.);
+  gemv(1., a, x, 2., y);
+  for (size_t i = 0; i < 1000; ++i) {
+    BOOST_CHECK_SMALL(y.at(i) - expected.at(i) - 2, 1e-10);
+  }
+
+  BOOST_CHECK_THROW(matvec(a, expected), std::length_error);
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_CASE(Cholesky_test) {
+  const size_t batch = 50, n = 6;
+  auto         m     = randomArray<double>({batch, n, n}, 8);
+
+  // A = M M^T + n I is symmetric positive definite
+  NdArray<double> a({batch, n, n});
+  for (size_t b = 0; b < batch; ++b) {
+    for (size_t i = 0; i < n; ++i) {
+      for (size_t j = 0; j < n; ++j) {
+        double sum = (i == j) ? n : 0;
+        for (size_t k = 0; k < n; ++k) {
+          sum += m.at(b, i, k) * m.at(b, j, k);
+        }
+        a.at(b, i, j) = sum;
+      }
+    }
+  }
+  // The last one is not positive definite
+  a.at(batch - 1, 0, 0) = -1;
+
+  auto l = a.copy();
+  BOOST_CHECK_EQUAL(choleskyBatch(l, 3), 1);
+
+  for (size_t b = 0; b < batch - 1; ++b) {
+    for (size_t i = 0; i < n; ++i) {
+      for (size_t j = 0; j < n; ++j) {
+        double sum = 0;
+        for (size_t k = 0; k < n; ++k) {
+          sum += l.at(b, i, k) * l.at(b, j, k);
+        }
+        BOOST_CHECK_SMALL(sum - a.at(b, i, j), 1e-10);
+        if (j > i) {
+          BOOST_CHECK_EQUAL(l.at(b, i, j), 0.);
+        }
+      }
+    }
+  }
+  BOOST_CHECK(std::isnan(l.at(batch - 1, 0, 0)));
+
+  NdArray<double> not_square({3, 4});
+  BOOST_CHECK_THROW(choleskyBatch(not_square), std::length_error);
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_CASE(LeastSquares_test) {
+  const size_t batch = 200, m = 9, n = 3;
+  auto         a     = randomArray<double>({batch, m, n}, 9);
+  auto         x     = randomArray<double>({batch, n}, 10);
+
+  // Exact observations, so the solution must be recovered
+  NdArray<double> b({batch, m});
+  for (size_t p = 0; p < batch; ++p) {
+    for (size_t r = 0; r < m; ++r) {
+      double sum = 0;
+      for (size_t c = 0; c < n; ++c) {
+        sum += a.at(p, r, c) * x.at(p, c);
+      }
+      b.at(p, r) = sum;
+    }
+  }
+  // The first problem is rank deficient
+  for (size_t r = 0; r < m; ++r) {
+    a.at(0, r, 2) = a.at(0, r, 1);
+  }
+
+  for (unsigned int n_threads : {1u, 4u}) {
+    auto solution = leastSquaresBatch(a, b, n_threads);
+    BOOST_CHECK(std::isnan(solution.at(0, 0)));
+    for (size_t p = 1; p < batch; ++p) {
+      for (size_t c = 0; c < n; ++c) {
+        BOOST_CHECK_SMALL(solution.at(p, c) - x.at(p, c), 1e-8);
+      }
+    }
+  }
+
+  // Single problem, overdetermined: fit a line
+  NdArray<double> design({4, 2}, std::vector<double>{1, 0, 1, 1, 1, 2, 1, 3});
+  NdArray<double> obs({4}, std::vector<double>{1, 3, 5, 8});
+  auto            line = leastSquaresBatch(design, obs);
+  BOOST_CHECK_EQUAL(line.shape().size(), 1);
+  BOOST_CHECK_CLOSE(line.at(0), 0.8, 1e-8);
+  BOOST_CHECK_CLOSE(line.at(1), 2.3, 1e-8);
+
+  BOOST_CHECK_THROW(leastSquaresBatch(a, obs), std::length_error);
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_SUITE_END()
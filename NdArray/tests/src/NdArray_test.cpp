@@ -178,7 +178,7 @@ BOOST_AUTO_TEST_CASE(Concatenate_test) {
   BOOST_CHECK_EQUAL(m.shape()[1], 3);
 
   std::vector<int> expected = values1;
-  std::copy(values2.begin(), values2.end(), std::back_inserter(values1));
+  std::copy(values2.begin(), values2.end(), std::back_inserter(expected));
 
   BOOST_CHECK_EQUAL_COLLECTIONS(expected.begin(), expected.end(), m.begin(), m.end());
 }
@@ -192,6 +192,122 @@ BOOST_AUTO_TEST_CASE(BadConcatenate_test) {
   BOOST_CHECK_THROW(m.concatenate(add2), std::length_error);
 }
 
+BOOST_AUTO_TEST_CASE(ConcatenateMany_test) {
+  // Big enough to be split between threads, with the split falling in the middle of the blocks
+  std::vector<NdArray<int>> blocks;
+  for (size_t i = 0; i < 7; ++i) {
+    NdArray<int> block{std::vector<size_t>{1000 * (i + 1), 5}};
+    std::fill(block.begin(), block.end(), static_cast<int>(i));
+    blocks.emplace_back(std::move(block));
+  }
+  // Non contiguous and empty blocks are fine too
+  NdArray<int> transposed{std::vector<size_t>{5, 3}, std::vector<int>{0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14}};
+  blocks.emplace_back(transposed.transpose());
+  blocks.emplace_back(std::vector<size_t>{0, 5});
+
+  for (unsigned int n_threads : {1u, 3u}) {
+    auto all = concatenate(blocks, n_threads);
+    BOOST_CHECK_EQUAL(all.shape()[0], 28003);
+    BOOST_CHECK_EQUAL(all.shape()[1], 5);
+    BOOST_CHECK_EQUAL(all.at(0, 0), 0);
+    BOOST_CHECK_EQUAL(all.at(999, 4), 0);
+    BOOST_CHECK_EQUAL(all.at(1000, 0), 1);
+    BOOST_CHECK_EQUAL(all.at(27999, 4), 6);
+    BOOST_CHECK_EQUAL(all.at(28000, 0), 0);
+    BOOST_CHECK_EQUAL(all.at(28000, 1), 3);
+    BOOST_CHECK_EQUAL(all.at(28002, 4), 14);
+  }
+
+  // Append to an existing array, keeping the attributes
+  NdArray<int> named{{2}, {"A", "B", "C", "D", "E"}};
+  named.concatenate(blocks, 2);
+  BOOST_CHECK_EQUAL(named.shape()[0], 28005);
+  BOOST_CHECK_EQUAL(named.at(2, "A"), 0);
+  BOOST_CHECK_EQUAL(named.at(28004, "E"), 14);
+
+  BOOST_CHECK_THROW(concatenate(std::vector<NdArray<int>>{}), std::invalid_argument);
+  blocks.emplace_back(std::vector<size_t>{2, 4});
+  BOOST_CHECK_THROW(concatenate(blocks), std::length_error);
+
+  NdArray<int> scalar{std::vector<size_t>{}};
+  BOOST_CHECK_THROW(scalar.concatenate(std::vector<NdArray<int>>{}), std::length_error);
+  BOOST_CHECK_THROW(scalar.concatenate(std::vector<NdArray<int>>{scalar}), std::length_error);
+}
+
+BOOST_AUTO_TEST_CASE(Reserve_test) {
+  NdArray<int> m{std::vector<size_t>{0, 3}};
+  m.reserve(100);
+  NdArray<int> row{std::vector<size_t>{1, 3}, std::vector<int>{1, 2, 3}};
+
+  m.concatenate(row);
+  auto data = m.data();
+  for (size_t i = 1; i < 100; ++i) {
+    m.concatenate(row);
+  }
+  // No reallocation
+  BOOST_CHECK_EQUAL(m.data(), data);
+  BOOST_CHECK_EQUAL(m.shape()[0], 100);
+  BOOST_CHECK_EQUAL(m.at(99, 2), 3);
+
+  BOOST_CHECK_THROW(m.transpose().reserve(200), std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_CASE(Transpose_test) {
+  NdArray<int> m{std::vector<size_t>{2, 3}, std::vector<int>{1, 2, 3, 4, 5, 6}};
+
+  auto t = m.transpose();
+  BOOST_CHECK_EQUAL(t.shape()[0], 3);
+  BOOST_CHECK_EQUAL(t.shape()[1], 2);
+  BOOST_CHECK(!t.isContiguous());
+
+  std::vector<int> expected{1, 4, 2, 5, 3, 6};
+  BOOST_CHECK_EQUAL_COLLECTIONS(expected.begin(), expected.end(), t.begin(), t.end());
+
+  // The data is shared
+  t.at(2, 0) = 42;
+  BOOST_CHECK_EQUAL(m.at(0, 2), 42);
+  BOOST_CHECK_THROW(t.reshape(6), std::invalid_argument);
+  BOOST_CHECK_THROW(t.concatenate(NdArray<int>{1, 2}), std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_CASE(PermuteAxes_test) {
+  NdArray<int> m{2, 3, 4};
+  std::iota(m.begin(), m.end(), 0);
+
+  auto p = m.permuteAxes({1, 2, 0});
+  BOOST_CHECK_EQUAL(p.shape()[0], 3);
+  BOOST_CHECK_EQUAL(p.shape()[1], 4);
+  BOOST_CHECK_EQUAL(p.shape()[2], 2);
+
+  for (size_t i = 0; i < 2; ++i) {
+    for (size_t j = 0; j < 3; ++j) {
+      for (size_t k = 0; k < 4; ++k) {
+        BOOST_CHECK_EQUAL(p.at(j, k, i), m.at(i, j, k));
+      }
+    }
+  }
+
+  BOOST_CHECK_THROW(m.permuteAxes({0, 1}), std::invalid_argument);
+  BOOST_CHECK_THROW(m.permuteAxes({0, 1, 1}), std::invalid_argument);
+  BOOST_CHECK_THROW(m.permuteAxes({0, 1, 3}), std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_CASE(Strided_test) {
+  std::vector<int> data(30);
+  std::iota(data.begin(), data.end(), 0);
+
+  // Every other column of a 5x6 matrix, skipping the first one
+  NdArray<int> view({5, 3}, {6, 2}, 1, std::move(data));
+  BOOST_CHECK(!view.isContiguous());
+  BOOST_CHECK_EQUAL(view.size(), 15);
+  BOOST_CHECK_EQUAL(view.at(0, 0), 1);
+  BOOST_CHECK_EQUAL(view.at(4, 2), 29);
+  BOOST_CHECK_EQUAL(std::accumulate(view.begin(), view.end(), 0), 225);
+
+  BOOST_CHECK_THROW(NdArray<int>({5, 3}, std::vector<size_t>{6}, 0, std::vector<int>(30)), std::invalid_argument);
+  BOOST_CHECK_THROW(NdArray<int>({5, 3}, {6, 2}, 2, std::vector<int>(30)), std::invalid_argument);
+}
+
 BOOST_AUTO_TEST_CASE(AttrNames_test) {
   const std::vector<std::string> attr_names{"ID", "SED", "PDZ"};
   NdArray<int>                   named{{20}, attr_names};
@@ -20,7 +20,9 @@
 #include "NdArray/io/NpyMmap.h"
 #include "TestHelper.h"
 #include <ElementsKernel/Temporary.h>
+#include <boost/filesystem/operations.hpp>
 #include <boost/test/unit_test.hpp>
+#include <type_traits>
 
 using namespace Euclid::NdArray;
 
@@ -86,6 +88,108 @@ BOOST_AUTO_TEST_CASE(MmapOpenPrivate_test) {
   BOOST_CHECK_EQUAL_COLLECTIONS(ndarray.begin(), ndarray.end(), read.begin(), read.end());
 }
 
+BOOST_AUTO_TEST_CASE(MmapAdvice_test) {
+  Elements::TempFile file("npy_mmap_advice_%%.npy");
+
+  NdArray<int32_t> ndarray({500, 10, 40});
+  std::generate(ndarray.begin(), ndarray.end(), []() { return std::rand() % 1024; });
+  writeNpy(file.path(), ndarray);
+
+  {
+    auto mmapped = mmapNpy<int32_t>(file.path(), boost::iostreams::mapped_file_base::readwrite, 0,
+                                    MemoryAdvice::SEQUENTIAL);
+    BOOST_CHECK_EQUAL_COLLECTIONS(ndarray.begin(), ndarray.end(), mmapped.begin(), mmapped.end());
+
+    mmapped.advise(MemoryAdvice::RANDOM);
+    mmapped.prefetch(100, 200);
+    mmapped.at(150, 1, 2) = 1024 + 42;
+    // Dropping the pages of a shared mapping does not lose the changes
+    mmapped.advise(MemoryAdvice::DONTNEED, 100, 200);
+    BOOST_CHECK_EQUAL(mmapped.at(150, 1, 2), 1024 + 42);
+
+    // Out of range positions are clipped, and views are supported
+    mmapped.prefetch(450, 1000);
+    mmapped.transpose().advise(MemoryAdvice::WILLNEED, 10, 20);
+    mmapped.advise(MemoryAdvice::NORMAL, 600, 700);
+  }
+
+  auto read = readNpy<int32_t>(file.path());
+  BOOST_CHECK_EQUAL(read.at(150, 1, 2), 1024 + 42);
+
+  // Private mappings keep their changes
+  {
+    auto mmapped = mmapNpy<int32_t>(file.path(), boost::iostreams::mapped_file_base::priv);
+    mmapped.at(0, 0, 0) = 2048;
+    mmapped.advise(MemoryAdvice::DONTNEED);
+    BOOST_CHECK_EQUAL(mmapped.at(0, 0, 0), 2048);
+  }
+
+  // Arrays in memory ignore the hints
+  ndarray.advise(MemoryAdvice::DONTNEED);
+  ndarray.prefetch(0, 10);
+  BOOST_CHECK_EQUAL(ndarray.at(0, 0, 0), read.at(0, 0, 0));
+}
+
+BOOST_AUTO_TEST_CASE(MmapReadOnly_test) {
+  Elements::TempFile file("npy_mmap_readonly_%%.npy");
+
+  NdArray<int32_t> ndarray({50, 10, 40});
+  std::generate(ndarray.begin(), ndarray.end(), []() { return std::rand() % 1024; });
+  writeNpy(file.path(), ndarray);
+  boost::filesystem::permissions(file.path(), boost::filesystem::owner_read);
+
+  // Several readers share the same file
+  auto first  = mmapNpyReadOnly<int32_t>(file.path());
+  auto second = mmapNpyReadOnly<int32_t>(file.path(), MemoryAdvice::RANDOM);
+  BOOST_CHECK(first.shape() == ndarray.shape());
+  BOOST_CHECK_EQUAL_COLLECTIONS(ndarray.begin(), ndarray.end(), first.begin(), first.end());
+  BOOST_CHECK_EQUAL_COLLECTIONS(ndarray.begin(), ndarray.end(), second.begin(), second.end());
+  BOOST_CHECK_NE(first.data(), second.data());
+
+  // The views are read-only, and the array can not be converted into a modifiable NdArray
+  auto transposed = first.transpose();
+  static_assert(std::is_same<decltype(transposed), ReadOnlyNdArray<int32_t>>::value, "Views must be read-only");
+  static_assert(std::is_same<decltype(transposed.at(0, 0, 0)), const int32_t&>::value, "Cells must be read-only");
+  static_assert(!std::is_convertible<ReadOnlyNdArray<int32_t>, NdArray<int32_t>>::value, "Must not be convertible");
+  static_assert(!std::is_constructible<NdArray<int32_t>, ReadOnlyNdArray<int32_t>>::value, "Must not be convertible");
+  BOOST_CHECK_EQUAL(transposed.at(39, 9, 49), ndarray.at(49, 9, 39));
+  BOOST_CHECK(first.permuteAxes({0, 1, 2}) == ndarray);
+
+  // A copy can be modified
+  auto copy        = first.copy();
+  copy.at(0, 0, 0) = 2048;
+  BOOST_CHECK_EQUAL(first.at(0, 0, 0), ndarray.at(0, 0, 0));
+
+  // The same mapping with the generic interface can not grow
+  auto mmapped = mmapNpy<int32_t>(file.path(), boost::iostreams::mapped_file_base::readonly);
+  BOOST_CHECK_EQUAL_COLLECTIONS(ndarray.begin(), ndarray.end(), mmapped.begin(), mmapped.end());
+  BOOST_CHECK_THROW(mmapped.concatenate(ndarray), Elements::Exception);
+
+  boost::filesystem::permissions(file.path(), boost::filesystem::owner_read | boost::filesystem::owner_write);
+}
+
+BOOST_AUTO_TEST_CASE(MmapFortran_test) {
+  Elements::TempFile file("npy_mmap_fortran_%%.npy");
+
+  constexpr const char* PYCODE = R"EDOCYP(
+import sys
+import numpy as np
+np.save(sys.argv[1], np.asfortranarray(np.arange(0, 60, dtype='=f8').reshape(3, 4, 5)))
+)EDOCYP";
+  runPython(PYCODE, file.path());
+
+  const auto mmapped = mmapNpy<double>(file.path());
+  BOOST_CHECK_EQUAL(mmapped.shape()[0], 3);
+  BOOST_CHECK_EQUAL(mmapped.shape()[1], 4);
+  BOOST_CHECK_EQUAL(mmapped.shape()[2], 5);
+  BOOST_CHECK(!mmapped.isContiguous());
+
+  std::vector<double> expected(60);
+  std::iota(expected.begin(), expected.end(), 0);
+  BOOST_CHECK_EQUAL_COLLECTIONS(mmapped.begin(), mmapped.end(), expected.begin(), expected.end());
+  BOOST_CHECK_EQUAL(mmapped.at(2, 1, 3), 2 * 20 + 1 * 5 + 3);
+}
+
 BOOST_AUTO_TEST_CASE(MmapCreate_test) {
   Elements::TempFile file("npy_create_mmap_%%.npy");
 
@@ -134,20 +238,100 @@ assert np.allclose(a[100:,:], 4.2)
   runPython(PYCODE, file.path());
 }
 
-BOOST_AUTO_TEST_CASE(MmapAppend_NotEnough_test) {
+BOOST_AUTO_TEST_CASE(MmapAppend_Grow_test) {
   Elements::TempFile file("npy_resize_mmap_%%.npy");
 
-  // This allocates only enough for the 100x2 doubles
-  auto ndarray = createMmapNpy<double>(file.path(), {100, 2});
-  for (size_t i = 0; i < 100; ++i) {
-    ndarray.at(i, 0) = i;
-    ndarray.at(i, 1) = 2 * i;
+  {
+    // This allocates only enough for the 100x2 doubles
+    auto ndarray = createMmapNpy<double>(file.path(), {100, 2});
+    for (size_t i = 0; i < 100; ++i) {
+      ndarray.at(i, 0) = i;
+      ndarray.at(i, 1) = 2 * i;
+    }
+
+    // The mapping must grow as needed
+    NdArray<double> another({50, 2});
+    std::fill(another.begin(), another.end(), 4.2);
+    for (size_t i = 0; i < 100; ++i) {
+      ndarray.concatenate(another);
+    }
+    BOOST_CHECK_EQUAL(ndarray.shape()[0], 5100);
+    BOOST_CHECK_EQUAL(ndarray.at(99, 1), 198);
+    BOOST_CHECK_EQUAL(ndarray.at(5099, 1), 4.2);
   }
 
-  NdArray<double> another({50, 2});
-  std::fill(another.begin(), another.end(), 4.2);
+  // Once released, the file must be truncated to the real size
+  auto read = readNpy<double>(file.path());
+  BOOST_CHECK_EQUAL(read.shape()[0], 5100);
+  BOOST_CHECK_EQUAL(boost::filesystem::file_size(file.path()) % 64, 0);
+  BOOST_CHECK_EQUAL(boost::filesystem::file_size(file.path()), 5100 * 2 * sizeof(double) + 128);
+
+  constexpr const char* PYCODE = R"EDOCYP(
+import sys
+import numpy as np
+a = np.load(sys.argv[1])
+assert a.shape == (5100, 2), a.shape
+assert np.allclose(a[100:,:], 4.2)
+)EDOCYP";
+  runPython(PYCODE, file.path());
+}
+
+BOOST_AUTO_TEST_CASE(MmapAppend_Reserve_test) {
+  Elements::TempFile file("npy_reserve_mmap_%%.npy");
+
+  {
+    auto ndarray = createMmapNpy<float>(file.path(), {10, 3});
+    ndarray.reserve(1000);
+    auto data = ndarray.data();
+
+    NdArray<float> another({10, 3});
+    std::fill(another.begin(), another.end(), 1.5);
+    for (size_t i = 0; i < 99; ++i) {
+      ndarray.concatenate(another);
+    }
+    // Not mapped again
+    BOOST_CHECK_EQUAL(ndarray.data(), data);
+    BOOST_CHECK_EQUAL(ndarray.shape()[0], 1000);
+  }
+
+  // The reserved space is not kept
+  auto read = readNpy<float>(file.path());
+  BOOST_CHECK_EQUAL(read.shape()[0], 1000);
+  BOOST_CHECK_EQUAL(read.at(999, 2), 1.5);
+  BOOST_CHECK_EQUAL(boost::filesystem::file_size(file.path()), 1000 * 3 * sizeof(float) + 128);
+}
+
+BOOST_AUTO_TEST_CASE(MmapAppend_Reopen_test) {
+  Elements::TempFile file("npy_resize_mmap_%%.npy");
+
+  NdArray<int32_t> rows({10, 3});
+  std::iota(rows.begin(), rows.end(), 0);
+  writeNpy(file.path(), rows);
+
+  // An existing file can also grow, and the reserved space is released when done
+  {
+    auto ndarray = mmapNpy<int32_t>(file.path(), boost::iostreams::mapped_file_base::readwrite, 4096);
+    ndarray.concatenate(rows);
+    ndarray.concatenate(rows);
+  }
+
+  auto read = readNpy<int32_t>(file.path());
+  BOOST_CHECK_EQUAL(read.shape()[0], 30);
+  BOOST_CHECK_EQUAL(read.at(29, 2), 29);
+  BOOST_CHECK_EQUAL(boost::filesystem::file_size(file.path()), 128 + 30 * 3 * sizeof(int32_t));
+}
+
+BOOST_AUTO_TEST_CASE(MmapAppend_ReopenInvalid_test) {
+  Elements::TempFile file("npy_resize_mmap_%%.npy");
+
+  NdArray<int32_t> rows({10, 3});
+  writeNpy(file.path(), rows);
+  auto file_size = boost::filesystem::file_size(file.path());
 
-  BOOST_CHECK_THROW(ndarray.concatenate(another), Elements::Exception);
+  // The file is not grown when the dtype does not match
+  BOOST_CHECK_THROW(mmapNpy<double>(file.path(), boost::iostreams::mapped_file_base::readwrite, 4096),
+                    Elements::Exception);
+  BOOST_CHECK_EQUAL(boost::filesystem::file_size(file.path()), file_size);
 }
 
 BOOST_AUTO_TEST_CASE(MmapNamed_test) {
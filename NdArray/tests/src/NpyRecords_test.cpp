@@ -0,0 +1,214 @@
+/*
+ * Copyright (C) 2012-2020 Euclid Science Ground Segment
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#include "NdArray/io/Npy.h"
+#include "NdArray/io/NpyRecords.h"
+#include "TestHelper.h"
+#include <ElementsKernel/Exception.h>
+#include <ElementsKernel/Temporary.h>
+#include <boost/test/unit_test.hpp>
+
+using namespace Euclid::NdArray;
+
+BOOST_AUTO_TEST_SUITE(NpyRecords_test)
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_CASE(PackedFromPython_test) {
+  Elements::TempFile file("npy_records_%%.npy");
+
+  constexpr const char* PYCODE = R"EDOCYP(
+import sys
+import numpy as np
+a = np.zeros(100, dtype=[('id', '<i8'), ('flux', '<f4', (9,)), ('flag', 'u1'), ('mag', '>f8')])
+a['id'] = np.arange(100) + 1000
+a['flux'] = np.arange(900).reshape(100, 9)
+a['flag'] = np.arange(100) % 2
+a['mag'] = np.arange(100) / 2.
+np.save(sys.argv[1], a)
+)EDOCYP";
+  runPython(PYCODE, file.path());
+
+  for (auto& records : {readNpyRecords(file.path()), mmapNpyRecords(file.path())}) {
+    BOOST_CHECK_EQUAL(records.size(), 100);
+    BOOST_CHECK_EQUAL(records.recordSize(), 53);
+    BOOST_CHECK_EQUAL(records.fields().size(), 4);
+    BOOST_CHECK_EQUAL(records.fieldInfo("flux").offset, 8);
+    BOOST_CHECK_EQUAL(records.fieldInfo("flux").count(), 9);
+
+    // Packed records are not aligned, so these are copies
+    auto id = records.field<int64_t>("id");
+    BOOST_CHECK_EQUAL(id.shape().size(), 1);
+    BOOST_CHECK_EQUAL(id.at(42), 1042);
+
+    auto flux = records.field<float>("flux");
+    BOOST_CHECK_EQUAL(flux.shape()[0], 100);
+    BOOST_CHECK_EQUAL(flux.shape()[1], 9);
+    BOOST_CHECK_EQUAL(flux.at(10, 3), 93);
+
+    auto flux_double = records.field<double>("flux");
+    BOOST_CHECK(std::equal(flux.begin(), flux.end(), flux_double.begin()));
+
+    // Single bytes are always a view
+    auto flag = records.field<uint8_t>("flag");
+    BOOST_CHECK(!flag.isContiguous());
+    BOOST_CHECK_EQUAL(flag.at(3), 1);
+    BOOST_CHECK_EQUAL(flag.at(4), 0);
+
+    // Big endian values are swapped
+    auto mag = records.field<double>("mag");
+    BOOST_CHECK_EQUAL(mag.at(99), 49.5);
+  }
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_CASE(AlignedView_test) {
+  Elements::TempFile file("npy_records_%%.npy");
+
+  constexpr const char* PYCODE = R"EDOCYP(
+import sys
+import numpy as np
+dt = np.dtype([('id', '<i8'), ('flux', '<f4', (3, 3)), ('flag', 'u1')], align=True)
+a = np.zeros(50, dtype=dt)
+a['id'] = np.arange(50)
+a['flux'] = np.arange(450).reshape(50, 3, 3)
+np.save(sys.argv[1], a)
+)EDOCYP";
+  runPython(PYCODE, file.path());
+
+  {
+    auto records = mmapNpyRecords(file.path());
+    BOOST_CHECK_EQUAL(records.recordSize(), 48);
+
+    auto id = records.field<int64_t>("id");
+    BOOST_CHECK_EQUAL(id.shape().size(), 1);
+    BOOST_CHECK(!id.isContiguous());
+    BOOST_CHECK_EQUAL(id.strides()[0], 6);
+    BOOST_CHECK_EQUAL(id.at(25), 25);
+
+    auto flux = records.field<float>("flux");
+    BOOST_CHECK_EQUAL(flux.shape().size(), 3);
+    BOOST_CHECK_EQUAL(flux.at(2, 1, 2), 2 * 9 + 1 * 3 + 2);
+    BOOST_CHECK_EQUAL(std::accumulate(flux.begin(), flux.end(), 0.), 449. * 450. / 2.);
+
+    // Modify through the views
+    std::transform(id.begin(), id.end(), id.begin(), [](int64_t v) { return v * 10; });
+    flux.at(49, 2, 2) = -1;
+  }
+
+  constexpr const char* PYCODE2 = R"EDOCYP(
+import sys
+import numpy as np
+a = np.load(sys.argv[1])
+assert (a['id'] == np.arange(50) * 10).all()
+assert a['flux'][49, 2, 2] == -1
+assert a['flux'][49, 2, 1] == 448
+)EDOCYP";
+  runPython(PYCODE2, file.path());
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_CASE(Create_test) {
+  Elements::TempFile file("npy_records_%%.npy");
+
+  {
+    auto records = createMmapNpyRecords(file.path(), {20}, {npyField<int64_t>("id"), npyField<double>("mag", {3})});
+    BOOST_CHECK_EQUAL(records.recordSize(), 32);
+
+    auto id  = records.field<int64_t>("id");
+    auto mag = records.field<double>("mag");
+    std::iota(id.begin(), id.end(), 0);
+    std::iota(mag.begin(), mag.end(), 0);
+  }
+
+  constexpr const char* PYCODE = R"EDOCYP(
+import sys
+import numpy as np
+a = np.load(sys.argv[1])
+assert a.shape == (20,)
+assert a.dtype.names == ('id', 'mag')
+assert (a['id'] == np.arange(20)).all()
+assert a['mag'].shape == (20, 3)
+assert (a['mag'] == np.arange(60).reshape(20, 3)).all()
+)EDOCYP";
+  runPython(PYCODE, file.path());
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_CASE(ReadOnly_test) {
+  Elements::TempFile file("npy_records_%%.npy");
+
+  {
+    auto records = createMmapNpyRecords(file.path(), {10}, {npyField<int64_t>("id"), npyField<double>("mag")});
+    auto id      = records.field<int64_t>("id");
+    std::iota(id.begin(), id.end(), 0);
+  }
+
+  auto records = mmapNpyRecords(file.path(), boost::iostreams::mapped_file_base::readonly);
+  BOOST_CHECK(records.isReadOnly());
+  BOOST_CHECK_THROW(records.field<int64_t>("id"), Elements::Exception);
+  BOOST_CHECK_THROW(records.data(), Elements::Exception);
+
+  // Only const access, so the field is a ReadOnlyNdArray
+  const auto&              const_records = records;
+  ReadOnlyNdArray<int64_t> id            = const_records.field<int64_t>("id");
+  BOOST_CHECK_EQUAL(id.at(7), 7);
+  BOOST_CHECK_EQUAL(const_records.field<double>("mag").at(7), 0.);
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_CASE(WriteRead_test) {
+  std::stringstream stream;
+
+  NpyRecordArray records({4, 5}, {npyField<int32_t>("a"), npyField<float>("b", {2})});
+  auto           a = records.field<int32_t>("a");
+  auto           b = records.field<float>("b");
+  BOOST_CHECK_EQUAL(a.shape().size(), 2);
+  BOOST_CHECK_EQUAL(b.shape().size(), 3);
+  std::iota(a.begin(), a.end(), 0);
+  std::iota(b.begin(), b.end(), 0);
+  writeNpyRecords(stream, records);
+
+  auto read = readNpyRecords(stream);
+  BOOST_CHECK_EQUAL(read.size(), 20);
+  BOOST_CHECK_EQUAL(read.recordSize(), 12);
+  BOOST_CHECK(read.field<int32_t>("a") == a);
+  BOOST_CHECK(read.field<float>("b") == b);
+  BOOST_CHECK_EQUAL(read.field<int64_t>("a").at(3, 4), 19);
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_CASE(Errors_test) {
+  std::stringstream stream;
+  writeNpy(stream, NdArray<float>({10}));
+  BOOST_CHECK_THROW(readNpyRecords(stream), Elements::Exception);
+
+  NpyRecordArray records({4}, {npyField<float>("a")});
+  BOOST_CHECK_THROW(records.fieldInfo("b"), Elements::Exception);
+  BOOST_CHECK_THROW(records.field<float>("b"), Elements::Exception);
+  BOOST_CHECK_THROW(records.field<int32_t>("a"), Elements::Exception);
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_SUITE_END()
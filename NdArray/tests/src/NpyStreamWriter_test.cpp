@@ -0,0 +1,143 @@
+/*
+ * Copyright (C) 2012-2020 Euclid Science Ground Segment
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#include "NdArray/io/Npy.h"
+#include "NdArray/io/NpyStreamWriter.h"
+#include "TestHelper.h"
+#include <ElementsKernel/Exception.h>
+#include <ElementsKernel/Temporary.h>
+#include <boost/test/unit_test.hpp>
+
+using namespace Euclid::NdArray;
+
+BOOST_AUTO_TEST_SUITE(NpyStreamWriter_test)
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_CASE(StreamChunks_test) {
+  std::stringstream stream;
+
+  NdArray<double> expected({0, 3});
+  {
+    NpyStreamWriter<double> writer(stream, {3});
+    BOOST_CHECK_EQUAL(writer.rowSize(), 3);
+    for (size_t chunk = 0; chunk < 5; ++chunk) {
+      NdArray<double> rows({chunk + 1, 3});
+      std::generate(rows.begin(), rows.end(), []() { return std::rand() % 100; });
+      writer.append(rows);
+      expected.concatenate(rows);
+    }
+    BOOST_CHECK_EQUAL(writer.rows(), 15);
+  }
+
+  auto read           = readNpy<double>(stream);
+  auto read_shape     = read.shape();
+  auto expected_shape = expected.shape();
+  BOOST_CHECK_EQUAL_COLLECTIONS(read_shape.begin(), read_shape.end(), expected_shape.begin(), expected_shape.end());
+  BOOST_CHECK_EQUAL_COLLECTIONS(read.begin(), read.end(), expected.begin(), expected.end());
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_CASE(StreamAligned_test) {
+  std::stringstream stream;
+  NpyStreamWriter<int32_t> writer(stream, {2, 2});
+  writer.close();
+  // The data must start on a 64 bytes boundary
+  BOOST_CHECK_EQUAL(stream.str().size() % 64, 0);
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_CASE(StreamTransposed_test) {
+  std::stringstream stream;
+
+  NdArray<int32_t> array({4, 3});
+  std::iota(array.begin(), array.end(), 0);
+  auto transposed = array.transpose();
+
+  NpyStreamWriter<int32_t> writer(stream, {4});
+  writer.append(transposed);
+  writer.close();
+
+  auto read = readNpy<int32_t>(stream);
+  BOOST_CHECK(read == transposed);
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_CASE(StreamAttributes_test) {
+  std::stringstream stream;
+
+  NdArray<float> rows({2}, std::vector<std::string>{"x", "y"});
+  std::iota(rows.begin(), rows.end(), 0);
+
+  NpyStreamWriter<float> writer(stream, {}, {"x", "y"});
+  writer.append(rows);
+  writer.append(rows);
+  writer.close();
+
+  auto read = readNpy<float>(stream);
+  BOOST_CHECK_EQUAL(read.shape()[0], 4);
+  BOOST_CHECK_EQUAL(read.shape()[1], 2);
+  BOOST_CHECK_EQUAL(read.attributes().size(), 2);
+  BOOST_CHECK_EQUAL(read.at(3, "y"), 3);
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_CASE(StreamBadShape_test) {
+  std::stringstream        stream;
+  NpyStreamWriter<int32_t> writer(stream, {3});
+  BOOST_CHECK_THROW(writer.append(NdArray<int32_t>({2, 4})), std::length_error);
+  BOOST_CHECK_THROW(writer.append(NdArray<int32_t>({3})), std::length_error);
+  writer.close();
+  int32_t value = 0;
+  BOOST_CHECK_THROW(writer.append(&value, 1), Elements::Exception);
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_CASE(StreamPython_test) {
+  Elements::TempFile file("npy_stream_%%.npy");
+
+  {
+    NpyStreamWriter<int64_t> writer(file.path(), {2});
+    for (int64_t chunk = 0; chunk < 10; ++chunk) {
+      std::vector<int64_t> rows(100 * 2);
+      std::iota(rows.begin(), rows.end(), chunk * 200);
+      writer.append(rows.data(), 100);
+    }
+  }
+
+  const char*  PYCODE = R"EDOCYP(
+import sys
+import numpy as np
+a = np.load(sys.argv[1])
+assert a.shape == (1000, 2)
+print(a[:,1].sum())
+)EDOCYP";
+  auto         output = runPython(PYCODE, file.path());
+  int64_t      sum;
+  output >> sum;
+  BOOST_CHECK_EQUAL(sum, 1000 * 1000);
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_SUITE_END()
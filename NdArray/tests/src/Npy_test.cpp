@@ -143,6 +143,28 @@ a = np.save(sys.argv[1], np.arange(0, 100, dtype='=u4').reshape(2, 5, 10))
   BOOST_CHECK_EQUAL(ndarray.shape()[2], 10);
 }
 
+BOOST_AUTO_TEST_CASE(Npy_fortran_test) {
+  Elements::TempFile file("npy_test_fortran_%%.npy");
+
+  constexpr const char* PYCODE = R"EDOCYP(
+import sys
+import numpy as np
+np.save(sys.argv[1], np.asfortranarray(np.arange(0, 100, dtype='=i4').reshape(2, 5, 10)))
+)EDOCYP";
+  runPython(PYCODE, file.path());
+
+  auto ndarray = readNpy<int32_t>(file.path());
+
+  BOOST_CHECK_EQUAL(ndarray.shape().size(), 3);
+  BOOST_CHECK_EQUAL(ndarray.shape()[0], 2);
+  BOOST_CHECK_EQUAL(ndarray.shape()[1], 5);
+  BOOST_CHECK_EQUAL(ndarray.shape()[2], 10);
+  BOOST_CHECK(ndarray.isContiguous());
+  for (int i = 0; i < 100; ++i) {
+    BOOST_CHECK_EQUAL(ndarray.data()[i], i);
+  }
+}
+
 BOOST_AUTO_TEST_CASE(Npy_badtype_test) {
   std::stringstream stream;
 
@@ -157,7 +179,7 @@ BOOST_AUTO_TEST_CASE(Npy_badtype_test) {
   BOOST_CHECK_THROW(readNpy<int64_t>(stream), Elements::Exception);
 }
 
-BOOST_AUTO_TEST_CASE(Npy_badendian_test) {
+BOOST_AUTO_TEST_CASE(Npy_bigendian_test) {
   Elements::TempFile file(std::string("npy_testpy_endian_%%.npy"));
 
   constexpr const char* PYCODE = R"EDOCYP(
@@ -168,7 +190,59 @@ np.save(sys.argv[1], np.arange(100, 400, dtype='>i8'))
 
   runPython(PYCODE, file.path());
 
-  BOOST_CHECK_THROW(readNpy<int64_t>(file.path()), Elements::Exception);
+  auto ndarray = readNpy<int64_t>(file.path());
+  BOOST_CHECK_EQUAL(ndarray.size(), 300);
+  for (size_t i = 0; i < ndarray.size(); ++i) {
+    BOOST_CHECK_EQUAL(ndarray.at(i), 100 + i);
+  }
+
+  // int64 can not be represented exactly as double
+  BOOST_CHECK_THROW(readNpy<double>(file.path()), Elements::Exception);
+}
+
+BOOST_AUTO_TEST_CASE(Npy_convert_test) {
+  Elements::TempFile file(std::string("npy_testpy_convert_%%.npy"));
+
+  constexpr const char* PYCODE = R"EDOCYP(
+import sys
+import numpy as np
+np.save(sys.argv[1], np.linspace(-1, 1, 3000000, dtype='>f4').reshape(1000, 3000))
+)EDOCYP";
+
+  runPython(PYCODE, file.path());
+
+  auto floats  = readNpy<float>(file.path());
+  auto doubles = readNpy<double>(file.path());
+  BOOST_CHECK_EQUAL(doubles.shape()[0], 1000);
+  BOOST_CHECK_EQUAL(doubles.shape()[1], 3000);
+  BOOST_CHECK_EQUAL(floats.at(0, 0), -1.f);
+  BOOST_CHECK_EQUAL(floats.at(999, 2999), 1.f);
+  BOOST_CHECK(std::equal(floats.begin(), floats.end(), doubles.begin()));
+
+  BOOST_CHECK_THROW(readNpy<int32_t>(file.path()), Elements::Exception);
+}
+
+BOOST_AUTO_TEST_CASE(Npy_convert_int_test) {
+  Elements::TempFile file(std::string("npy_testpy_convert_%%.npy"));
+
+  constexpr const char* PYCODE = R"EDOCYP(
+import sys
+import numpy as np
+np.save(sys.argv[1], np.arange(-50, 50, dtype='i1'))
+)EDOCYP";
+
+  runPython(PYCODE, file.path());
+
+  auto int8    = readNpy<int8_t>(file.path());
+  auto int32   = readNpy<int32_t>(file.path());
+  auto float32 = readNpy<float>(file.path());
+  BOOST_CHECK_EQUAL(int32.size(), 100);
+  BOOST_CHECK_EQUAL(int8.at(0), -50);
+  BOOST_CHECK_EQUAL(int32.at(0), -50);
+  BOOST_CHECK_EQUAL(float32.at(99), 49.f);
+
+  // Signed into unsigned is not safe
+  BOOST_CHECK_THROW(readNpy<uint32_t>(file.path()), Elements::Exception);
 }
 
 BOOST_AUTO_TEST_CASE(AttrNames_test) {
@@ -0,0 +1,230 @@
+/*
+ * Copyright (C) 2012-2020 Euclid Science Ground Segment
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#include "NdArray/io/Npz.h"
+#include "TestHelper.h"
+#include <ElementsKernel/Exception.h>
+#include <ElementsKernel/Temporary.h>
+#include <boost/filesystem/operations.hpp>
+#include <boost/test/unit_test.hpp>
+#include <fstream>
+#include <iterator>
+
+using namespace Euclid::NdArray;
+
+BOOST_AUTO_TEST_SUITE(Npz_test)
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_CASE(NpzStored_test) {
+  Elements::TempFile file("npz_stored_%%.npz");
+
+  NdArray<int32_t> ints({5, 10, 4});
+  NdArray<double>  doubles({20}, std::vector<std::string>{"a", "b"});
+  std::generate(ints.begin(), ints.end(), []() { return std::rand() % 1024; });
+  std::generate(doubles.begin(), doubles.end(), []() { return std::rand() % 1024; });
+
+  {
+    NpzWriter writer(file.path());
+    writer.write("ints", ints);
+    writer.write("doubles", doubles);
+    BOOST_CHECK_THROW(writer.write("ints", ints), std::invalid_argument);
+  }
+
+  NpzReader reader(file.path());
+  auto      keys = reader.keys();
+  BOOST_CHECK_EQUAL(keys.size(), 2);
+  BOOST_CHECK(reader.contains("ints"));
+  BOOST_CHECK(reader.contains("doubles"));
+  BOOST_CHECK(!reader.isCompressed("ints"));
+
+  {
+    auto read = reader.read<int32_t>("ints");
+    BOOST_CHECK(read == ints);
+    // The writer aligns the data, so it must be used in place
+    BOOST_CHECK_EQUAL(reinterpret_cast<uintptr_t>(read.data()) % 64, 0);
+    // Modifications do not reach the file
+    read.at(0, 0, 0) = 2048;
+  }
+  BOOST_CHECK_EQUAL(NpzReader(file.path()).read<int32_t>("ints").at(0, 0, 0), ints.at(0, 0, 0));
+
+  auto read = reader.read<double>("doubles");
+  BOOST_CHECK(read == doubles);
+  BOOST_CHECK_EQUAL(read.attributes().size(), 2);
+  BOOST_CHECK_EQUAL(read.at(5, "b"), doubles.at(5, "b"));
+
+  // Resizing moves the data out of the mapping
+  read.concatenate(doubles);
+  BOOST_CHECK_EQUAL(read.shape()[0], 40);
+  BOOST_CHECK_EQUAL(read.at(25, "a"), doubles.at(5, "a"));
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_CASE(NpzCompressed_test) {
+  Elements::TempFile stored_file("npz_stored_%%.npz");
+  Elements::TempFile compressed_file("npz_compressed_%%.npz");
+
+  NdArray<int64_t> array({100, 100});
+  std::iota(array.begin(), array.end(), 0);
+
+  NpzWriter(stored_file.path()).write("array", array);
+  NpzWriter(compressed_file.path(), 6).write("array", array.transpose());
+
+  NpzReader reader(compressed_file.path());
+  BOOST_CHECK(reader.isCompressed("array"));
+  auto read = reader.read<int64_t>("array");
+  BOOST_CHECK(read == array.transpose());
+
+  BOOST_CHECK_LT(boost::filesystem::file_size(compressed_file.path()), boost::filesystem::file_size(stored_file.path()));
+
+  // Stored and compressed members are converted the same way
+  NdArray<int32_t> small({10, 10});
+  std::iota(small.begin(), small.end(), 0);
+  NdArray<double> expected({10, 10});
+  std::iota(expected.begin(), expected.end(), 0.);
+  {
+    NpzWriter writer(compressed_file.path(), 6);
+    writer.write("compressed", small);
+    NpzWriter(stored_file.path()).write("stored", small);
+  }
+  BOOST_CHECK(NpzReader(stored_file.path()).read<double>("stored") == expected);
+  BOOST_CHECK(NpzReader(compressed_file.path()).read<double>("compressed") == expected);
+  BOOST_CHECK_THROW(NpzReader(stored_file.path()).read<int16_t>("stored"), Elements::Exception);
+  BOOST_CHECK_THROW(NpzReader(compressed_file.path()).read<int16_t>("compressed"), Elements::Exception);
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_CASE(NpzErrors_test) {
+  Elements::TempFile file("npz_errors_%%.npz");
+
+  BOOST_CHECK_THROW(NpzWriter(file.path(), 10), std::invalid_argument);
+  NpzWriter(file.path()).write("array", NdArray<float>({10}));
+
+  NpzReader reader(file.path());
+  BOOST_CHECK_THROW(reader.read<float>("missing"), Elements::Exception);
+  BOOST_CHECK_THROW(reader.read<int32_t>("array"), Elements::Exception);
+
+  Elements::TempFile not_zip("npz_errors_%%.npz");
+  std::ofstream(not_zip.path().native()) << "This is not a zip file";
+  BOOST_CHECK_THROW(NpzReader{not_zip.path()}, Elements::Exception);
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_CASE(NpzCorrupted_test) {
+  Elements::TempFile file("npz_corrupted_%%.npz");
+  NpzWriter(file.path()).write("array", NdArray<float>({10}));
+
+  std::string content;
+  {
+    std::ifstream input(file.path().native(), std::ios::binary);
+    content.assign(std::istreambuf_iterator<char>(input), std::istreambuf_iterator<char>());
+  }
+  auto central = content.find("PK\x01\x02");
+  BOOST_REQUIRE(central != std::string::npos);
+
+  auto corrupt = [&file](std::string bytes) {
+    std::ofstream(file.path().native(), std::ios::binary).write(bytes.data(), bytes.size());
+    BOOST_CHECK_THROW(NpzReader{file.path()}, Elements::Exception);
+  };
+
+  // The name goes past the end of the file
+  auto long_name = content;
+  long_name[central + 28] = long_name[central + 29] = '\xff';
+  corrupt(long_name);
+
+  // The extra field covers the end record, whose signature is read as a field with a length past the extra field
+  auto bad_extra          = content;
+  bad_extra[central + 30] = 8;
+  bad_extra[central + 31] = 0;
+  corrupt(bad_extra);
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_CASE(NpzFromPython_test) {
+  Elements::TempFile file("npz_python_%%.npz");
+  Elements::TempFile compressed_file("npz_python_%%.npz");
+
+  const char* PYCODE = R"EDOCYP(
+import sys
+import numpy as np
+a = np.arange(0, 100, dtype='=i4').reshape(2, 5, 10)
+b = np.asfortranarray(np.arange(0, 12, dtype='=f8').reshape(3, 4))
+c = np.arange(0, 10, dtype='>f8')
+np.savez(sys.argv[1], a=a, b=b, c=c)
+np.savez_compressed(sys.argv[1].replace('.npz', '_c.npz'), a=a, b=b, c=c)
+)EDOCYP";
+  runPython(PYCODE, file.path());
+
+  auto compressed_path = file.path().parent_path() / (file.path().stem().native() + "_c.npz");
+  boost::filesystem::rename(compressed_path, compressed_file.path());
+
+  for (auto& path : {file.path(), compressed_file.path()}) {
+    NpzReader reader(path);
+    BOOST_CHECK_EQUAL(reader.isCompressed("a"), path == compressed_file.path());
+
+    auto a = reader.read<int32_t>("a");
+    BOOST_CHECK_EQUAL(a.shape().size(), 3);
+    BOOST_CHECK_EQUAL(a.at(1, 2, 3), 73);
+
+    auto b = reader.read<double>("b");
+    BOOST_CHECK_EQUAL(b.shape()[0], 3);
+    BOOST_CHECK_EQUAL(b.shape()[1], 4);
+    BOOST_CHECK_EQUAL(b.at(2, 1), 9);
+
+    // Big-endian values are converted whether stored or compressed
+    auto c = reader.read<double>("c");
+    BOOST_CHECK_EQUAL(c.shape().size(), 1);
+    BOOST_CHECK_EQUAL(c.at(7), 7.);
+  }
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_CASE(NpzToPython_test) {
+  Elements::TempFile file("npz_python_%%.npz");
+
+  NdArray<float> values({100, 3});
+  std::iota(values.begin(), values.end(), 0);
+  {
+    NpzWriter writer(file.path(), 1);
+    writer.write("values", values);
+    writer.write("column", contiguousCopy(values.transpose()));
+  }
+
+  const char* PYCODE = R"EDOCYP(
+import sys
+import numpy as np
+with np.load(sys.argv[1]) as npz:
+    assert npz['values'].shape == (100, 3)
+    assert npz['column'].shape == (3, 100)
+    assert (npz['values'].T == npz['column']).all()
+    print(npz['values'][:, 1].sum())
+)EDOCYP";
+  auto        output = runPython(PYCODE, file.path());
+  float       sum;
+  output >> sum;
+  BOOST_CHECK_EQUAL(sum, 14950);
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_SUITE_END()
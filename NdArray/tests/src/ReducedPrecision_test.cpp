@@ -0,0 +1,269 @@
+/*
+ * Copyright (C) 2012-2020 Euclid Science Ground Segment
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#include "NdArray/ReducedPrecision.h"
+#include "NdArray/io/Npy.h"
+#include "TestHelper.h"
+#include <ElementsKernel/Temporary.h>
+#include <boost/test/unit_test.hpp>
+#include <cmath>
+#include <random>
+
+using namespace Euclid::NdArray;
+
+BOOST_AUTO_TEST_SUITE(ReducedPrecision_test)
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_CASE(Float16_test) {
+  BOOST_CHECK_EQUAL(Float16(1.f).bits(), 0x3c00);
+  BOOST_CHECK_EQUAL(Float16(-2.f).bits(), 0xc000);
+  BOOST_CHECK_EQUAL(Float16(65504.f).bits(), 0x7bff);
+  BOOST_CHECK_EQUAL(Float16(0.f).bits(), 0);
+  BOOST_CHECK_EQUAL(Float16(-0.f).bits(), 0x8000);
+  // Smallest subnormal
+  BOOST_CHECK_EQUAL(Float16(std::ldexp(1.f, -24)).bits(), 1);
+  BOOST_CHECK_EQUAL(float(Float16::fromBits(1)), std::ldexp(1.f, -24));
+  // Ties round to even
+  BOOST_CHECK_EQUAL(Float16(1.f + std::ldexp(1.f, -11)).bits(), 0x3c00);
+  BOOST_CHECK_EQUAL(Float16(1.f + 3 * std::ldexp(1.f, -11)).bits(), 0x3c02);
+  // Overflow, infinity and NaN
+  BOOST_CHECK_EQUAL(Float16(65520.f).bits(), 0x7c00);
+  BOOST_CHECK_EQUAL(Float16(-std::numeric_limits<float>::infinity()).bits(), 0xfc00);
+  BOOST_CHECK(std::isnan(float(Float16(std::numeric_limits<float>::quiet_NaN()))));
+  BOOST_CHECK_EQUAL(float(std::numeric_limits<Float16>::max()), 65504.f);
+  BOOST_CHECK_EQUAL(float(std::numeric_limits<Float16>::epsilon()), std::ldexp(1.f, -10));
+
+  // Every value survives a round trip through float
+  for (uint32_t bits = 0; bits <= 0xffff; ++bits) {
+    float value = Float16::fromBits(bits);
+    if (!std::isnan(value)) {
+      BOOST_REQUIRE_EQUAL(Float16(value).bits(), bits);
+    }
+  }
+
+  // Arithmetic goes through float
+  Float16 a(1.5f), b(2.f);
+  BOOST_CHECK_EQUAL(a * b, 3.f);
+  BOOST_CHECK(a < b);
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_CASE(BFloat16_test) {
+  BOOST_CHECK_EQUAL(BFloat16(1.f).bits(), 0x3f80);
+  BOOST_CHECK_EQUAL(float(BFloat16(3.f)), 3.f);
+  BOOST_CHECK_CLOSE(float(BFloat16(1e30f)), 1e30f, 0.4);
+  // Ties round to even
+  BOOST_CHECK_EQUAL(BFloat16(1.f + std::ldexp(1.f, -8)).bits(), 0x3f80);
+  BOOST_CHECK_EQUAL(BFloat16(1.f + 3 * std::ldexp(1.f, -8)).bits(), 0x3f82);
+  BOOST_CHECK(std::isnan(float(BFloat16(std::numeric_limits<float>::quiet_NaN()))));
+  BOOST_CHECK(std::isinf(float(BFloat16(std::numeric_limits<float>::infinity()))));
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_CASE(ConvertValues_test) {
+  std::mt19937                          rng(42);
+  std::uniform_real_distribution<float> dist(-1000, 1000);
+  std::vector<float>                    values(1003);
+  std::generate(values.begin(), values.end(), [&]() { return dist(rng); });
+  values[5] = std::ldexp(1.f, -20);
+  values[6] = 1e6f;
+
+  // The bulk conversion must match the scalar one
+  std::vector<Float16> halfs(values.size());
+  std::vector<float>   back(values.size());
+  convertValues(values.data(), halfs.data(), values.size());
+  convertValues(halfs.data(), back.data(), values.size());
+  for (size_t i = 0; i < values.size(); ++i) {
+    BOOST_CHECK_EQUAL(halfs[i].bits(), Float16(values[i]).bits());
+    BOOST_CHECK_EQUAL(back[i], float(halfs[i]));
+  }
+
+  std::vector<double> doubles(values.begin(), values.end());
+  std::vector<double> doubles_back(values.size());
+  convertValues(doubles.data(), halfs.data(), values.size());
+  convertValues(halfs.data(), doubles_back.data(), values.size());
+  for (size_t i = 0; i < values.size(); ++i) {
+    BOOST_CHECK_EQUAL(doubles_back[i], back[i]);
+  }
+
+  std::vector<BFloat16> bhalfs(values.size());
+  convertValues(doubles.data(), bhalfs.data(), values.size());
+  convertValues(bhalfs.data(), doubles_back.data(), values.size());
+  for (size_t i = 0; i < values.size(); ++i) {
+    BOOST_CHECK_CLOSE(doubles_back[i], doubles[i], 0.4);
+  }
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_CASE(ConvertArray_test) {
+  NdArray<double> grid({200, 700});
+  std::iota(grid.begin(), grid.end(), 0.);
+  std::transform(grid.begin(), grid.end(), grid.begin(), [](double v) { return std::sin(v / 1000.); });
+
+  for (unsigned int n_threads : {1u, 3u}) {
+    auto half = convertArray<Float16>(grid, n_threads);
+    BOOST_CHECK(half.shape() == grid.shape());
+    auto restored = convertArray<double>(half, n_threads);
+    for (size_t i = 0; i < 200; ++i) {
+      for (size_t j = 0; j < 700; ++j) {
+        BOOST_CHECK_SMALL(restored.at(i, j) - grid.at(i, j), 1e-3);
+      }
+    }
+  }
+
+  // Non contiguous source
+  auto transposed = convertArray<float>(grid.transpose(), 2);
+  BOOST_CHECK_EQUAL(transposed.shape()[0], 700);
+  BOOST_CHECK_EQUAL(transposed.at(650, 123), static_cast<float>(grid.at(123, 650)));
+
+  // The attribute names are kept
+  NdArray<double> named(std::vector<size_t>{10}, std::vector<std::string>{"flux", "error"});
+  std::iota(named.begin(), named.end(), 0.);
+  auto named_half = convertArray<Float16>(named);
+  BOOST_CHECK(named_half.shape() == named.shape());
+  BOOST_CHECK(named_half.attributes() == named.attributes());
+  BOOST_CHECK_EQUAL(static_cast<float>(named_half.at(7, "error")), 15.f);
+  auto named_raw = quantize<int16_t>(named, 0.01, 0.);
+  BOOST_CHECK(named_raw.attributes() == named.attributes());
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_CASE(Quantize_test) {
+  NdArray<double> values({1000});
+  for (size_t i = 0; i < 1000; ++i) {
+    values.at(i) = -5. + i * 0.0137;
+  }
+  values.at(3) = std::numeric_limits<double>::quiet_NaN();
+
+  auto scaling = quantizationFor<int16_t>(-5., 9.);
+  auto raw     = quantize<int16_t>(values, scaling.first, scaling.second);
+  BOOST_CHECK_EQUAL(raw.at(0), -32767);
+  BOOST_CHECK_EQUAL(raw.at(3), std::numeric_limits<int16_t>::lowest());
+
+  auto restored = dequantize<float>(raw, scaling.first, scaling.second, 2);
+  BOOST_CHECK(std::isnan(restored.at(3)));
+  for (size_t i = 0; i < 1000; ++i) {
+    if (i != 3) {
+      BOOST_CHECK_SMALL(restored.at(i) - values.at(i), scaling.first);
+    }
+  }
+
+  // Out of range values are clipped
+  auto clipped = quantize<uint8_t>(values, 0.1, 0.);
+  BOOST_CHECK_EQUAL(clipped.at(0), 1);
+  BOOST_CHECK_EQUAL(clipped.at(999), 87);
+
+  BOOST_CHECK_THROW(quantize<int8_t>(values, 0., 0.), std::invalid_argument);
+  BOOST_CHECK_THROW(quantizationFor<int8_t>(1., 1.), std::invalid_argument);
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_CASE(Quantize64_test) {
+  NdArray<double> values({3}, std::vector<double>{0., 0.5, 1.});
+
+  // The limits of 64 bits integers are not representable as doubles
+  auto signed_scaling = quantizationFor<int64_t>(0., 1.);
+  auto signed_raw     = quantize<int64_t>(values, signed_scaling.first, signed_scaling.second);
+  BOOST_CHECK_GT(signed_raw.at(0), std::numeric_limits<int64_t>::lowest());
+  BOOST_CHECK_LT(signed_raw.at(0), 0);
+  BOOST_CHECK_GT(signed_raw.at(2), 0);
+  auto signed_restored = dequantize<double>(signed_raw, signed_scaling.first, signed_scaling.second);
+
+  auto unsigned_scaling = quantizationFor<uint64_t>(0., 1.);
+  auto unsigned_raw     = quantize<uint64_t>(values, unsigned_scaling.first, unsigned_scaling.second);
+  BOOST_CHECK_EQUAL(unsigned_raw.at(0), 1);
+  BOOST_CHECK_GT(unsigned_raw.at(2), unsigned_raw.at(1));
+  auto unsigned_restored = dequantize<double>(unsigned_raw, unsigned_scaling.first, unsigned_scaling.second);
+
+  for (size_t i = 0; i < 3; ++i) {
+    BOOST_CHECK_SMALL(signed_restored.at(i) - values.at(i), 1e-12);
+    BOOST_CHECK_SMALL(unsigned_restored.at(i) - values.at(i), 1e-12);
+  }
+
+  // Out of range values are clipped within the range, not onto the blank
+  NdArray<double> extremes({2}, std::vector<double>{-1e30, 1e30});
+  auto            clipped = quantize<int64_t>(extremes, 1., 0.);
+  BOOST_CHECK_GT(clipped.at(0), std::numeric_limits<int64_t>::lowest());
+  BOOST_CHECK_GT(clipped.at(1), 0);
+  auto unsigned_clipped = quantize<uint64_t>(extremes, 1., 0.);
+  BOOST_CHECK_EQUAL(unsigned_clipped.at(0), 1);
+  BOOST_CHECK_GT(unsigned_clipped.at(1), 1);
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_CASE(Npy_test) {
+  NdArray<Float16> half({3, 4});
+  for (size_t i = 0; i < half.size(); ++i) {
+    *(half.begin() + i) = 0.1f * i - 0.5f;
+  }
+
+  std::stringstream stream;
+  writeNpy(stream, half);
+  BOOST_CHECK_NE(stream.str().find("'descr': '<f2'"), std::string::npos);
+
+  stream.seekg(0);
+  auto read = readNpy<Float16>(stream);
+  BOOST_CHECK(read.shape() == half.shape());
+  for (size_t i = 0; i < half.size(); ++i) {
+    BOOST_CHECK_EQUAL((*(read.begin() + i)).bits(), (*(half.begin() + i)).bits());
+  }
+
+  // Safe cast into wider types
+  stream.seekg(0);
+  auto doubles = readNpy<double>(stream);
+  BOOST_CHECK_EQUAL(doubles.at(2, 3), float(half.at(2, 3)));
+
+  // But not the other way around
+  std::stringstream float_stream;
+  writeNpy(float_stream, doubles);
+  float_stream.seekg(0);
+  BOOST_CHECK_THROW(readNpy<Float16>(float_stream), Elements::Exception);
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_CASE(Npy_python_test) {
+  Elements::TempFile file(std::string("npy_testpy_f2_%%.npy"));
+
+  constexpr const char* PYCODE = R"EDOCYP(
+import sys
+import numpy as np
+np.save(sys.argv[1], np.linspace(-100, 100, 20001, dtype='>f2'))
+)EDOCYP";
+
+  runPython(PYCODE, file.path());
+
+  auto half   = readNpy<Float16>(file.path());
+  auto floats = readNpy<float>(file.path());
+  BOOST_CHECK_EQUAL(half.shape()[0], 20001);
+  BOOST_CHECK_EQUAL(float(half.at(0)), -100.f);
+  BOOST_CHECK_EQUAL(float(half.at(20000)), 100.f);
+  BOOST_CHECK_EQUAL(float(half.at(10005)), float(Float16(0.05f)));
+  BOOST_CHECK(std::equal(half.begin(), half.end(), floats.begin()));
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_SUITE_END()
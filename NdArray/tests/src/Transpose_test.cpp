@@ -0,0 +1,80 @@
+/*
+ * Copyright (C) 2012-2020 Euclid Science Ground Segment
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#include "NdArray/Transpose.h"
+#include <boost/test/unit_test.hpp>
+
+using namespace Euclid::NdArray;
+
+BOOST_AUTO_TEST_SUITE(Transpose_test)
+
+BOOST_AUTO_TEST_CASE(TransposeCopy_test) {
+  NdArray<double> m{70, 45};
+  std::iota(m.begin(), m.end(), 0.);
+
+  auto t = transposeCopy(m);
+  BOOST_CHECK(t.isContiguous());
+  BOOST_CHECK_EQUAL(t.shape()[0], 45);
+  BOOST_CHECK_EQUAL(t.shape()[1], 70);
+  for (size_t i = 0; i < 70; ++i) {
+    for (size_t j = 0; j < 45; ++j) {
+      BOOST_CHECK_EQUAL(t.at(j, i), m.at(i, j));
+    }
+  }
+
+  // Not shared
+  t.at(0, 0) = -1;
+  BOOST_CHECK_EQUAL(m.at(0, 0), 0.);
+}
+
+BOOST_AUTO_TEST_CASE(PermuteCopy_test) {
+  NdArray<int> m{5, 40, 37, 3};
+  std::iota(m.begin(), m.end(), 0);
+
+  for (auto& axes : std::vector<std::vector<size_t>>{{0, 1, 2, 3}, {3, 2, 1, 0}, {1, 0, 2, 3}, {0, 3, 1, 2}, {2, 3, 0, 1}}) {
+    auto view = m.permuteAxes(axes);
+    for (unsigned int n_threads : {1u, 3u}) {
+      auto copy = permuteAxesCopy(m, axes, n_threads);
+      BOOST_CHECK(copy.isContiguous());
+      BOOST_CHECK(copy.shape() == view.shape());
+      BOOST_CHECK_EQUAL_COLLECTIONS(copy.begin(), copy.end(), view.begin(), view.end());
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(PaddedSource_test) {
+  NdArray<float> m{std::vector<size_t>{4, 3}, std::vector<float>{0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11}};
+
+  auto copy = contiguousCopy(m.transpose().transpose());
+  BOOST_CHECK(copy == m);
+}
+
+BOOST_AUTO_TEST_CASE(KeepAttributes_test) {
+  NdArray<int> m{{4}, {"A", "B", "C"}};
+  std::iota(m.begin(), m.end(), 0);
+
+  auto copy = permuteAxesCopy(m, {0, 1});
+  BOOST_CHECK_EQUAL(copy.attributes().size(), 3);
+  BOOST_CHECK_EQUAL(copy.at(2, "B"), 7);
+
+  auto transposed = transposeCopy(m);
+  BOOST_CHECK(transposed.attributes().empty());
+  BOOST_CHECK_EQUAL(transposed.at(1, 2), 7);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,85 @@
+/*
+ * Copyright (C) 2012-2020 Euclid Science Ground Segment
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+/**
+ * @file Table/ColumnArray.h
+ * @date 10/19/26
+ */
+
+#ifndef _TABLE_COLUMNARRAY_H
+#define _TABLE_COLUMNARRAY_H
+
+#include "NdArray/NdArray.h"
+#include "Table/Table.h"
+#include <string>
+#include <vector>
+
+namespace Euclid {
+namespace Table {
+
+/**
+ * @brief
+ * Copy the values of a numeric column into an NdArray
+ *
+ * @details
+ * The type of the column is resolved once, so the values are copied in a single typed pass over the rows,
+ * without visiting the variant of each cell. The conversions follow the same rules as CastVisitor: integers
+ * can be converted into wider integers or any floating point type, and float into double.
+ *
+ * Scalar columns give an array with shape (rows). Columns of vectors or NdArrays give an array with
+ * shape (rows, cell shape...), so all their cells must have the same shape.
+ *
+ * The Table stores its cells row by row, and is immutable, so the column is always copied, even for a single
+ * row table with a NdArray<T> cell.
+ *
+ * @param table The table
+ * @param column The name of the column
+ * @param n_threads Number of threads to use. 0 means one per available core.
+ * @return A new contiguous NdArray
+ * @throws Elements::Exception
+ *    if there is no column with such name, it can not be converted into T, or its cells have different shapes
+ */
+template <typename T>
+NdArray::NdArray<T> columnToNdArray(const Table& table, const std::string& column, unsigned int n_threads = 1);
+
+/**
+ * @brief
+ * Copy the values of several numeric columns into a single NdArray
+ *
+ * @details
+ * The columns are copied with a single pass over the rows, so the values of each row are read together.
+ * The result has shape (rows, columns) for scalar columns, and (rows, columns, cell shape...) for columns of
+ * vectors or NdArrays. All the columns must have cells with the same shape.
+ *
+ * @param table The table
+ * @param columns The names of the columns
+ * @param n_threads Number of threads to use. 0 means one per available core.
+ * @return A new contiguous NdArray
+ * @throws Elements::Exception
+ *    if any column does not exist, can not be converted into T, or the cells have different shapes
+ */
+template <typename T>
+NdArray::NdArray<T> columnsToNdArray(const Table& table, const std::vector<std::string>& columns,
+                                     unsigned int n_threads = 1);
+
+}  // namespace Table
+}  // namespace Euclid
+
+#include "Table/_impl/ColumnArray.icpp"
+
+#endif
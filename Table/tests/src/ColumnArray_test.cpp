@@ -0,0 +1,149 @@
+/*
+ * Copyright (C) 2012-2020 Euclid Science Ground Segment
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+/**
+ * @file tests/src/ColumnArray_test.cpp
+ * @date 10/19/26
+ */
+
+#include "ElementsKernel/Exception.h"
+#include "Table/ColumnArray.h"
+#include <boost/test/unit_test.hpp>
+
+using namespace Euclid::Table;
+using Euclid::NdArray::NdArray;
+
+struct ColumnArray_Fixture {
+  std::vector<ColumnInfo::info_type> info_list{ColumnInfo::info_type("Id", typeid(int64_t)),
+                                               ColumnInfo::info_type("Name", typeid(std::string)),
+                                               ColumnInfo::info_type("Flux", typeid(float)),
+                                               ColumnInfo::info_type("Error", typeid(double)),
+                                               ColumnInfo::info_type("Flag", typeid(bool)),
+                                               ColumnInfo::info_type("Bands", typeid(std::vector<double>)),
+                                               ColumnInfo::info_type("Errors", typeid(std::vector<double>)),
+                                               ColumnInfo::info_type("Pdf", typeid(NdArray<float>))};
+  std::shared_ptr<ColumnInfo>        column_info{new ColumnInfo{info_list}};
+  std::vector<Row>                   rows;
+
+  ColumnArray_Fixture() {
+    for (int64_t i = 0; i < 1000; ++i) {
+      NdArray<float> pdf({2, 3});
+      std::fill(pdf.begin(), pdf.end(), i * 0.5f);
+      rows.emplace_back(std::vector<Row::cell_type>{i, std::string{"source"}, i * 1.5f, i * 0.1, i % 2 == 0,
+                                                    std::vector<double>{i * 1., i * 2., i * 3.},
+                                                    std::vector<double>{-1., -2., -3.}, pdf},
+                        column_info);
+    }
+  }
+};
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_SUITE(ColumnArray_test)
+
+//-----------------------------------------------------------------------------
+
+BOOST_FIXTURE_TEST_CASE(ScalarColumn, ColumnArray_Fixture) {
+
+  // Given
+  Table table{rows};
+
+  // When
+  auto ids    = columnToNdArray<int64_t>(table, "Id");
+  auto fluxes = columnToNdArray<double>(table, "Flux", 3);
+  auto flags  = columnToNdArray<int32_t>(table, "Flag");
+
+  // Then
+  BOOST_CHECK(ids.shape() == std::vector<size_t>{1000});
+  BOOST_CHECK(fluxes.shape() == std::vector<size_t>{1000});
+  for (size_t i = 0; i < 1000; ++i) {
+    BOOST_CHECK_EQUAL(ids.at(i), i);
+    BOOST_CHECK_EQUAL(fluxes.at(i), i * 1.5f);
+    BOOST_CHECK_EQUAL(flags.at(i), i % 2 == 0);
+  }
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_FIXTURE_TEST_CASE(MultipleColumns, ColumnArray_Fixture) {
+
+  // Given
+  Table table{rows};
+
+  // When
+  auto scalars = columnsToNdArray<double>(table, {"Id", "Flux", "Error"}, 2);
+  auto vectors = columnsToNdArray<double>(table, {"Bands", "Errors"});
+  auto pdf     = columnToNdArray<double>(table, "Pdf");
+
+  // Then
+  BOOST_CHECK(scalars.shape() == std::vector<size_t>({1000, 3}));
+  BOOST_CHECK(vectors.shape() == std::vector<size_t>({1000, 2, 3}));
+  BOOST_CHECK(pdf.shape() == std::vector<size_t>({1000, 2, 3}));
+  for (size_t i = 0; i < 1000; ++i) {
+    BOOST_CHECK_EQUAL(scalars.at(i, 0), i);
+    BOOST_CHECK_EQUAL(scalars.at(i, 1), i * 1.5f);
+    BOOST_CHECK_EQUAL(scalars.at(i, 2), i * 0.1);
+    BOOST_CHECK_EQUAL(vectors.at(i, 0, 2), i * 3.);
+    BOOST_CHECK_EQUAL(vectors.at(i, 1, 2), -3.);
+    BOOST_CHECK_EQUAL(pdf.at(i, 1, 2), i * 0.5f);
+  }
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_FIXTURE_TEST_CASE(SingleRowCopy, ColumnArray_Fixture) {
+
+  // Given
+  Table table{{rows[7]}};
+
+  // When
+  auto pdf = columnToNdArray<float>(table, "Pdf");
+  pdf.at(0, 1, 1) = -1.f;
+
+  // Then
+  BOOST_CHECK(pdf.shape() == std::vector<size_t>({1, 2, 3}));
+  // The table is not modified
+  auto& cell = boost::get<NdArray<float>>(table[0]["Pdf"]);
+  BOOST_CHECK_NE(pdf.data(), cell.data());
+  BOOST_CHECK_EQUAL(cell.at(1, 1), 3.5f);
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_FIXTURE_TEST_CASE(InvalidColumns, ColumnArray_Fixture) {
+
+  // Given
+  rows.emplace_back(std::vector<Row::cell_type>{int64_t{0}, std::string{"short"}, 0.f, 0., true, std::vector<double>{1.},
+                                                std::vector<double>{1., 2., 3.}, NdArray<float>({2, 3})},
+                    column_info);
+  Table table{rows};
+
+  // Then
+  BOOST_CHECK_THROW(columnToNdArray<double>(table, "Missing"), Elements::Exception);
+  BOOST_CHECK_THROW(columnToNdArray<double>(table, "Name"), Elements::Exception);
+  // Lossy conversions are not allowed
+  BOOST_CHECK_THROW(columnToNdArray<float>(table, "Error"), Elements::Exception);
+  BOOST_CHECK_THROW(columnToNdArray<int32_t>(table, "Id"), Elements::Exception);
+  // The last row has a shorter vector
+  BOOST_CHECK_THROW(columnToNdArray<double>(table, "Bands"), Elements::Exception);
+  BOOST_CHECK_THROW(columnsToNdArray<double>(table, {"Id", "Errors"}), Elements::Exception);
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_SUITE_END()